@@ -0,0 +1,139 @@
+/* chash_bench -- mesure le débit de CHashTable de 1 à 32 threads, pour
+ * plusieurs proportions de lectures, et le compare à celui d'une
+ * HashTable protégée par un seul verrou.
+ *
+ * Usage: chash_bench [nombre d'opérations par thread]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "chash.h"
+#include "hash.h"
+
+#define NKEYS (1 << 16)         /* Nombre de clés distinctes */
+
+static int keys[NKEYS];
+static int nops = 1000000;      /* Opérations par thread */
+static int read_pct;            /* Proportion de lectures (en %) */
+
+static CHashTable *ctable;
+static HashTable *table;
+static pthread_mutex_t table_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static int int_hash(void *k)
+{
+  return *(int *) k;
+}
+
+static int int_equal(void *a, void *b)
+{
+  return *(int *) a == *(int *) b;
+}
+
+/* next_random -- générateur xorshift propre à chaque thread */
+static uint32_t next_random(uint64_t *state)
+{
+  *state ^= *state << 13;
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+  return (uint32_t) (*state >> 32);
+}
+
+/* Les écritures sont pour moitié des insertions, pour moitié des
+ * suppressions, ce qui garde la table à moitié pleine.
+ */
+static void *chash_worker(void *arg)
+{
+  uint64_t state = 0x9E3779B97F4A7C15ULL * ((uintptr_t) arg + 1);
+  uint32_t r;
+  int i, *k;
+
+  for (i = 0; i < nops; i++) {
+    r = next_random(&state);
+    k = &keys[r % NKEYS];
+    if ((int) ((r >> 16) % 100) < read_pct)
+      chash_table_find(ctable, k);
+    else if (r & 0x8000)
+      chash_table_insert(ctable, k, k);
+    else
+      chash_table_remove(ctable, k);
+  }
+  return NULL;
+}
+
+static void *hash_worker(void *arg)
+{
+  uint64_t state = 0x9E3779B97F4A7C15ULL * ((uintptr_t) arg + 1);
+  uint32_t r;
+  int i, *k;
+
+  for (i = 0; i < nops; i++) {
+    r = next_random(&state);
+    k = &keys[r % NKEYS];
+    pthread_mutex_lock(&table_lock);
+    if ((int) ((r >> 16) % 100) < read_pct)
+      hash_table_find(table, k);
+    else if (r & 0x8000)
+      hash_table_insert(table, k, k);
+    else
+      hash_table_remove(table, k);
+    pthread_mutex_unlock(&table_lock);
+  }
+  return NULL;
+}
+
+/* run -- lance nthreads threads exécutant worker et renvoie le débit
+ * obtenu, en millions d'opérations par seconde.
+ */
+static double run(void *(*worker)(void *), int nthreads)
+{
+  pthread_t threads[32];
+  struct timespec start, end;
+  double secs;
+  int i;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (i = 0; i < nthreads; i++)
+    pthread_create(&threads[i], NULL, worker, (void *) (uintptr_t) i);
+  for (i = 0; i < nthreads; i++)
+    pthread_join(threads[i], NULL);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  secs = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+  return (double) nops * nthreads / secs / 1e6;
+}
+
+int main(int argc, char **argv)
+{
+  static const int ratios[] = {50, 90, 99};
+  int r, t, i;
+
+  if (argc > 1)
+    nops = atoi(argv[1]);
+  for (i = 0; i < NKEYS; i++)
+    keys[i] = i;
+  printf("%-8s %-8s %14s %14s\n", "lectures", "threads", "chash (Mop/s)", "hash+verrou");
+  for (r = 0; r < (int) (sizeof(ratios)/sizeof(ratios[0])); r++) {
+    read_pct = ratios[r];
+    for (t = 1; t <= 32; t *= 2) {
+      ctable = chash_table_new(NKEYS, int_hash, int_equal);
+      table = hash_table_new(NKEYS, int_hash, int_equal);
+      if ((ctable == NULL) || (table == NULL)) {
+        fprintf(stderr, "chash_bench: erreur d'allocation mémoire.\n");
+        return 1;
+      }
+      for (i = 0; i < NKEYS; i += 2) {
+        chash_table_insert(ctable, &keys[i], &keys[i]);
+        hash_table_insert(table, &keys[i], &keys[i]);
+      }
+      printf("%7d%% %8d %14.2f", read_pct, t, run(chash_worker, t));
+      printf(" %14.2f\n", run(hash_worker, t));
+      fflush(stdout);
+      chash_table_free(ctable);
+      hash_table_free(table);
+    }
+  }
+  return 0;
+}
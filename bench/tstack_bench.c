@@ -0,0 +1,128 @@
+/* tstack_bench -- mesure le débit de TStack de 1 à 32 threads, et le
+ * compare à celui d'une SList protégée par un seul verrou. Chaque thread
+ * empile puis dépile, une donnée à la fois ou par lots.
+ *
+ * Usage: tstack_bench [nombre d'opérations par thread]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "tstack.h"
+#include "slist.h"
+
+#define BATCH 16                /* Taille des lots */
+
+static int nops = 1000000;      /* Opérations par thread */
+static int batch;               /* Empile et dépile par lots */
+static int items[BATCH];
+
+static TStack *stack;
+static SList *list;
+static pthread_mutex_t list_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void drop(void *item, void *data)
+{
+  (void) item;
+  (void) data;
+}
+
+static void *tstack_worker(void *arg)
+{
+  void *tab[BATCH];
+  int i, j;
+
+  (void) arg;
+  for (j = 0; j < BATCH; j++)
+    tab[j] = &items[j];
+  if (batch)
+    for (i = 0; i < nops; i += 2*BATCH) {
+      tstack_push_batch(stack, tab, BATCH);
+      tstack_pop_all(stack, drop, NULL);
+    }
+  else
+    for (i = 0; i < nops; i += 2) {
+      tstack_push(stack, &items[0]);
+      tstack_pop(stack);
+    }
+  return NULL;
+}
+
+/* La liste est utilisée comme une pile: on insère et on retire en tete */
+static void *slist_worker(void *arg)
+{
+  int i, j;
+
+  (void) arg;
+  if (batch)
+    for (i = 0; i < nops; i += 2*BATCH) {
+      pthread_mutex_lock(&list_lock);
+      for (j = 0; j < BATCH; j++) {
+        slist_reset(list);
+        slist_insert(list, &items[j]);
+      }
+      pthread_mutex_unlock(&list_lock);
+      pthread_mutex_lock(&list_lock);
+      for (slist_reset(list); !slist_empty(list); slist_reset(list))
+        slist_remove(list);
+      pthread_mutex_unlock(&list_lock);
+    }
+  else
+    for (i = 0; i < nops; i += 2) {
+      pthread_mutex_lock(&list_lock);
+      slist_reset(list);
+      slist_insert(list, &items[0]);
+      pthread_mutex_unlock(&list_lock);
+      pthread_mutex_lock(&list_lock);
+      slist_reset(list);
+      slist_remove(list);
+      pthread_mutex_unlock(&list_lock);
+    }
+  return NULL;
+}
+
+/* run -- lance nthreads threads exécutant worker et renvoie le débit
+ * obtenu, en millions d'opérations par seconde.
+ */
+static double run(void *(*worker)(void *), int nthreads)
+{
+  pthread_t threads[32];
+  struct timespec start, end;
+  double secs;
+  int i;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (i = 0; i < nthreads; i++)
+    pthread_create(&threads[i], NULL, worker, (void *) (uintptr_t) i);
+  for (i = 0; i < nthreads; i++)
+    pthread_join(threads[i], NULL);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  secs = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+  return (double) nops * nthreads / secs / 1e6;
+}
+
+int main(int argc, char **argv)
+{
+  int t;
+
+  if (argc > 1)
+    nops = atoi(argv[1]);
+  printf("%-8s %-8s %14s %14s\n", "lots", "threads", "tstack (Mop/s)", "slist+verrou");
+  for (batch = 0; batch <= 1; batch++)
+    for (t = 1; t <= 32; t *= 2) {
+      stack = tstack_new();
+      list = slist_new();
+      if ((stack == NULL) || (list == NULL)) {
+        fprintf(stderr, "tstack_bench: erreur d'allocation mémoire.\n");
+        return 1;
+      }
+      printf("%-8s %8d %14.2f", batch ? "oui" : "non", t, run(tstack_worker, t));
+      printf(" %14.2f\n", run(slist_worker, t));
+      fflush(stdout);
+      tstack_free(stack);
+      slist_free(list);
+    }
+  return 0;
+}
@@ -0,0 +1,286 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "bloom.h"
+#include "hashfn.h"
+
+/* Nombre de clés traitées par paquet dans les recherches groupées */
+#define BLOOM_BATCH 16
+
+/* Constantes impaires utilisées pour placer les bits d'une clé: la i-ème
+ * donne la position du i-ème bit.
+ */
+static const uint32_t bloom_salts[BLOOM_MAX_K] = {
+  0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+  0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U,
+  0x9e3779b1U, 0x85ebca77U, 0xc2b2ae3dU, 0x27d4eb2fU,
+  0x165667b1U, 0xd3a2646dU, 0xfd7046c5U, 0xb55a4f09U
+};
+
+/* bloom_estimate (fonction interne) -- estime le taux de faux positifs
+ * d'un filtre à k bits par clé contenant en moyenne load clés par bloc.
+ * Le nombre de clés d'un bloc suit une loi de Poisson de paramètre load,
+ * et un bloc de j clés se comporte comme un petit filtre classique.
+ * Complexité: O(load)
+ */
+static double bloom_estimate(int k, double load)
+{
+  double p = exp(-load);        /* Probabilité qu'un bloc ait j clés */
+  double fpr = 0.0;
+  int j, bits = 64 * BLOOM_BLOCK_WORDS;
+
+  for (j = 0; j < 4*load + 64; j++) {
+    fpr += p * pow(1.0 - pow(1.0 - 1.0/bits, (double) k * j), k);
+    p *= load / (j + 1);
+  }
+  return fpr;
+}
+
+/* bloom_new -- crée un filtre vide prévu pour max_size clés, avec un
+ * taux de faux positifs fpr (entre 0 et 1 exclus) à pleine charge.
+ * h peut etre NULL si on n'utilise que les fonctions bloom_xxx_hash.
+ * Retourne un pointeur sur ce filtre, ou NULL en cas d'échec.
+ * Complexité: O(max_size)
+ */
+Bloom *bloom_new(int max_size, double fpr, int (*h)(void *))
+{
+  Bloom *tmp;
+  double bits_per_key;
+  void *blocks;
+
+  assert((max_size > 0) && (fpr > 0.0) && (fpr < 1.0));
+  /* Filtre classique optimal: -ln(fpr)/ln(2)^2 bits par clé, et
+   * ln(2) fois autant de bits à 1 par clé.
+   */
+  bits_per_key = -log(fpr) / (M_LN2 * M_LN2);
+  if ((tmp = (Bloom *) malloc(sizeof(Bloom))) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "bloom_new: erreur d'allocation mémoire.\n");
+#endif
+    return NULL;
+  }
+  tmp->k = (int) (bits_per_key * M_LN2 + 0.5);
+  if (tmp->k < 1) tmp->k = 1;
+  if (tmp->k > BLOOM_MAX_K) tmp->k = BLOOM_MAX_K;
+  /* Les blocs n'ont pas tous le meme nombre de clés, et les plus chargés
+   * donnent plus de faux positifs: on ajoute des blocs jusqu'à ce que le
+   * taux estimé soit atteint.
+   */
+  tmp->nblocks = (int) ceil(bits_per_key * max_size / (64 * BLOOM_BLOCK_WORDS));
+  while (bloom_estimate(tmp->k, (double) max_size / tmp->nblocks) > fpr)
+    tmp->nblocks += tmp->nblocks/20 + 1;
+  if (posix_memalign(&blocks, sizeof(BloomBlock), tmp->nblocks*sizeof(BloomBlock)) != 0) {
+#ifdef DEBUG
+    fprintf(stderr, "bloom_new: erreur d'allocation mémoire.\n");
+#endif
+    free(tmp);
+    return NULL;
+  }
+  tmp->blocks = (BloomBlock *) blocks;
+  tmp->h = h;
+  bloom_clear(tmp);
+  return tmp;
+}
+
+/* bloom_free -- détruit un filtre et libère la mémoire qu'il occupait.
+ * Complexité: O(1)
+ */
+void bloom_free(Bloom *b)
+{
+  assert(b != NULL);
+  free(b->blocks);
+  free(b);
+}
+
+/* bloom_clear -- vide le filtre.
+ * Complexité: O(taille du filtre)
+ */
+void bloom_clear(Bloom *b)
+{
+  assert(b != NULL);
+  memset(b->blocks, 0, b->nblocks*sizeof(BloomBlock));
+  b->size = 0;
+}
+
+/* bloom_size -- renvoie le nombre de clés ajoutées au filtre.
+ * Complexité: O(1)
+ */
+int bloom_size(Bloom *b)
+{
+  assert(b != NULL);
+  return b->size;
+}
+
+/* bloom_block (fonction interne) -- renvoie le bloc de la clé de code
+ * hash. Les 32 bits de poids fort du code sont ramenés entre 0 et
+ * nblocks-1 par une multiplication plutot qu'une division.
+ * Complexité: O(1)
+ */
+static BloomBlock *bloom_block(Bloom *b, uint64_t hash)
+{
+  return &b->blocks[((hash >> 32) * (uint64_t) b->nblocks) >> 32];
+}
+
+/* bloom_mask (fonction interne) -- calcule dans mask les bits de la clé
+ * de code hash à l'intérieur de son bloc. Le i-ème bit est donné par les
+ * 9 bits de poids fort (3 pour le mot, 6 pour le bit dans le mot) du
+ * produit des 32 bits de poids faible de hash par la i-ème constante.
+ * Complexité: O(k)
+ */
+static void bloom_mask(Bloom *b, uint64_t hash, uint64_t mask[BLOOM_BLOCK_WORDS])
+{
+  uint32_t h2 = (uint32_t) hash;
+  uint32_t x;
+  int i;
+
+  for (i = 0; i < BLOOM_BLOCK_WORDS; i++)
+    mask[i] = 0;
+  for (i = 0; i < b->k; i++) {
+    x = h2 * bloom_salts[i];
+    mask[x >> 29] |= (uint64_t) 1 << ((x >> 23) & 63);
+  }
+}
+
+/* bloom_test (fonction interne) -- détermine si tous les bits de mask
+ * sont à 1 dans le bloc block.
+ * Complexité: O(1)
+ */
+static int bloom_test(const BloomBlock *block, const uint64_t mask[BLOOM_BLOCK_WORDS])
+{
+#ifdef __SSE2__
+  __m128i acc = _mm_setzero_si128();
+  __m128i m;
+  int i;
+
+  /* Accumule les bits du masque absents du bloc */
+  for (i = 0; i < BLOOM_BLOCK_WORDS; i += 2) {
+    m = _mm_loadu_si128((const __m128i *) (mask + i));
+    acc = _mm_or_si128(acc, _mm_andnot_si128(_mm_load_si128((const __m128i *) (block->words + i)), m));
+  }
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(acc, _mm_setzero_si128())) == 0xFFFF;
+#else
+  uint64_t missing = 0;
+  int i;
+
+  for (i = 0; i < BLOOM_BLOCK_WORDS; i++)
+    missing |= mask[i] & ~block->words[i];
+  return missing == 0;
+#endif
+}
+
+/* bloom_add_hash -- ajoute au filtre la clé de code de hachage hash.
+ * Complexité: O(1)
+ */
+void bloom_add_hash(Bloom *b, uint64_t hash)
+{
+  uint64_t mask[BLOOM_BLOCK_WORDS];
+  BloomBlock *block;
+  int i;
+
+  assert(b != NULL);
+  block = bloom_block(b, hash);
+  bloom_mask(b, hash, mask);
+  for (i = 0; i < BLOOM_BLOCK_WORDS; i++)
+    block->words[i] |= mask[i];
+  b->size += 1;
+}
+
+/* bloom_contains_hash -- renvoie 0 si la clé de code de hachage hash n'a
+ * sûrement pas été ajoutée, 1 sinon.
+ * Complexité: O(1)
+ */
+int bloom_contains_hash(Bloom *b, uint64_t hash)
+{
+  uint64_t mask[BLOOM_BLOCK_WORDS];
+
+  assert(b != NULL);
+  bloom_mask(b, hash, mask);
+  return bloom_test(bloom_block(b, hash), mask);
+}
+
+/* bloom_key_hash (fonction interne) -- renvoie le code de hachage de 64
+ * bits de key.
+ * Complexité: O(C(h))
+ */
+static uint64_t bloom_key_hash(Bloom *b, void *key)
+{
+  assert(b->h != NULL);
+  return hash_mix64((uint64_t) (uint32_t) b->h(key));
+}
+
+/* bloom_add -- ajoute key au filtre.
+ * Complexité: O(1)
+ */
+void bloom_add(Bloom *b, void *key)
+{
+  assert(b != NULL);
+  bloom_add_hash(b, bloom_key_hash(b, key));
+}
+
+/* bloom_contains -- renvoie 0 si key n'a sûrement pas été ajoutée, 1
+ * sinon.
+ * Complexité: O(1)
+ */
+int bloom_contains(Bloom *b, void *key)
+{
+  assert(b != NULL);
+  return bloom_contains_hash(b, bloom_key_hash(b, key));
+}
+
+/* bloom_contains_batch_hash -- teste n codes de hachage d'un coup: out[i]
+ * reçoit bloom_contains_hash(b, hashes[i]). Les blocs de toutes les clés
+ * sont demandés à la mémoire avant d'etre testés, ce qui recouvre les
+ * défauts de cache.
+ * Renvoie le nombre de réponses positives.
+ * Complexité: O(n)
+ */
+int bloom_contains_batch_hash(Bloom *b, const uint64_t *hashes, int n,
+                              unsigned char *out)
+{
+  uint64_t mask[BLOOM_BLOCK_WORDS];
+  BloomBlock *blocks[BLOOM_BATCH];
+  int i, j, len, count = 0;
+
+  assert((b != NULL) && ((n == 0) || ((hashes != NULL) && (out != NULL))));
+  for (i = 0; i < n; i += BLOOM_BATCH) {
+    len = (n - i < BLOOM_BATCH) ? n - i : BLOOM_BATCH;
+    for (j = 0; j < len; j++) {
+      blocks[j] = bloom_block(b, hashes[i + j]);
+#ifdef __GNUC__
+      __builtin_prefetch(blocks[j]);
+#endif
+    }
+    for (j = 0; j < len; j++) {
+      bloom_mask(b, hashes[i + j], mask);
+      out[i + j] = (unsigned char) bloom_test(blocks[j], mask);
+      count += out[i + j];
+    }
+  }
+  return count;
+}
+
+/* bloom_contains_batch -- comme bloom_contains_batch_hash, pour les n
+ * clés du tableau keys.
+ * Renvoie le nombre de réponses positives.
+ * Complexité: O(n)
+ */
+int bloom_contains_batch(Bloom *b, void **keys, int n, unsigned char *out)
+{
+  uint64_t hashes[BLOOM_BATCH];
+  int i, j, len, count = 0;
+
+  assert((b != NULL) && ((n == 0) || ((keys != NULL) && (out != NULL))));
+  for (i = 0; i < n; i += BLOOM_BATCH) {
+    len = (n - i < BLOOM_BATCH) ? n - i : BLOOM_BATCH;
+    for (j = 0; j < len; j++)
+      hashes[j] = bloom_key_hash(b, keys[i + j]);
+    count += bloom_contains_batch_hash(b, hashes, len, out + i);
+  }
+  return count;
+}
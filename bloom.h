@@ -0,0 +1,108 @@
+#ifndef BLOOM_H
+#define BLOOM_H
+
+#include <stdint.h>
+
+/* Filtre de Bloom par blocs.
+ * Le filtre répond à la question "key a-t-elle été ajoutée ?" par "non"
+ * (sur) ou "peut-etre" (avec une probabilité d'erreur choisie à la
+ * création). Placé devant une HashTable ou l'ensemble des aretes d'un
+ * graphe, il évite la plupart des recherches infructueuses.
+ *
+ * Le filtre est découpé en blocs de 512 bits, soit une ligne de cache:
+ * tous les bits d'une clé sont dans le meme bloc, si bien qu'une
+ * recherche ne lit qu'une seule ligne de cache. Dans le bloc, les
+ * positions des k bits d'une clé sont obtenues en multipliant son code de
+ * hachage par k constantes différentes, sans autre calcul de hachage; le
+ * test compare alors le bloc entier au masque de la clé en quelques
+ * instructions SSE2.
+ *
+ * Regrouper les bits d'une clé augmente un peu le taux de faux positifs
+ * (les blocs les plus chargés en donnent davantage); le filtre est donc
+ * un peu plus grand que ce que demanderait un filtre de Bloom classique,
+ * d'autant plus que le taux demandé est faible.
+ *
+ * Les fonctions bloom_xxx_hash travaillent directement sur un code de
+ * hachage de 64 bits (voir hashfn.h), les autres sur une clé convertie
+ * en entier par la fonction h donnée à la création, comme pour
+ * HashTable.
+ */
+
+#define BLOOM_BLOCK_WORDS 8     /* Mots de 64 bits par bloc */
+#define BLOOM_MAX_K 16          /* Nombre maximum de bits par clé */
+
+typedef struct {
+  _Alignas(64) uint64_t words[BLOOM_BLOCK_WORDS];
+} BloomBlock;
+
+typedef struct {
+  int nblocks;                  /* Nombre de blocs */
+  int k;                        /* Nombre de bits par clé */
+  int size;                     /* Nombre de clés ajoutées */
+  int (*h)(void *);             /* Convertit une clé en entier */
+  BloomBlock *blocks;           /* Les blocs */
+} Bloom;
+
+/* bloom_new -- crée un filtre vide prévu pour max_size clés, avec un
+ * taux de faux positifs fpr (entre 0 et 1 exclus) à pleine charge.
+ * h peut etre NULL si on n'utilise que les fonctions bloom_xxx_hash.
+ * Retourne un pointeur sur ce filtre, ou NULL en cas d'échec.
+ * Complexité: O(max_size)
+ */
+extern Bloom *bloom_new(int max_size, double fpr, int (*h)(void *));
+
+/* bloom_free -- détruit un filtre et libère la mémoire qu'il occupait.
+ * Complexité: O(1)
+ */
+extern void bloom_free(Bloom *b);
+
+/* bloom_clear -- vide le filtre.
+ * Complexité: O(taille du filtre)
+ */
+extern void bloom_clear(Bloom *b);
+
+/* bloom_size -- renvoie le nombre de clés ajoutées au filtre.
+ * Complexité: O(1)
+ */
+extern int bloom_size(Bloom *b);
+
+/* bloom_add_hash -- ajoute au filtre la clé de code de hachage hash.
+ * Complexité: O(1)
+ */
+extern void bloom_add_hash(Bloom *b, uint64_t hash);
+
+/* bloom_contains_hash -- renvoie 0 si la clé de code de hachage hash n'a
+ * sûrement pas été ajoutée, 1 sinon.
+ * Complexité: O(1)
+ */
+extern int bloom_contains_hash(Bloom *b, uint64_t hash);
+
+/* bloom_add -- ajoute key au filtre.
+ * Complexité: O(1)
+ */
+extern void bloom_add(Bloom *b, void *key);
+
+/* bloom_contains -- renvoie 0 si key n'a sûrement pas été ajoutée, 1
+ * sinon.
+ * Complexité: O(1)
+ */
+extern int bloom_contains(Bloom *b, void *key);
+
+/* bloom_contains_batch_hash -- teste n codes de hachage d'un coup: out[i]
+ * reçoit bloom_contains_hash(b, hashes[i]). Les blocs de toutes les clés
+ * sont demandés à la mémoire avant d'etre testés, ce qui recouvre les
+ * défauts de cache.
+ * Renvoie le nombre de réponses positives.
+ * Complexité: O(n)
+ */
+extern int bloom_contains_batch_hash(Bloom *b, const uint64_t *hashes, int n,
+                                     unsigned char *out);
+
+/* bloom_contains_batch -- comme bloom_contains_batch_hash, pour les n
+ * clés du tableau keys.
+ * Renvoie le nombre de réponses positives.
+ * Complexité: O(n)
+ */
+extern int bloom_contains_batch(Bloom *b, void **keys, int n, unsigned char *out);
+
+#endif /* BLOOM_H */
@@ -0,0 +1,456 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "chash.h"
+#include "hashfn.h"
+
+/* Prochain compteur de lecteurs à attribuer à un nouveau thread */
+static atomic_int chash_next_reader = 0;
+
+/* chash_reader (fonction interne) -- renvoie le numéro du compteur de
+ * lecteurs du thread appelant. Il est attribué au premier appel; au-delà
+ * de CHASH_READERS threads, plusieurs threads partagent un compteur.
+ * Complexité: O(1)
+ */
+static int chash_reader(void)
+{
+  static _Thread_local int reader = -1;
+
+  if (reader < 0)
+    reader = atomic_fetch_add(&chash_next_reader, 1) % CHASH_READERS;
+  return reader;
+}
+
+/* chash_enter (fonction interne) -- annonce le thread appelant comme
+ * lecteur dans l'époque courante, et renvoie cette époque.
+ * Si l'époque change entre sa lecture et l'annonce, on recommence: un
+ * lecteur n'est jamais annoncé dans une époque déjà close.
+ * Complexité: O(1)
+ */
+static unsigned long chash_enter(CHashTable *table, int reader)
+{
+  unsigned long e;
+
+  for (;;) {
+    e = atomic_load(&table->epoch);
+    atomic_fetch_add(&table->readers[reader].count[e % 3], 1);
+    if (atomic_load(&table->epoch) == e)
+      return e;
+    atomic_fetch_sub(&table->readers[reader].count[e % 3], 1);
+  }
+}
+
+/* chash_leave (fonction interne) -- retire l'annonce faite par
+ * chash_enter.
+ * Complexité: O(1)
+ */
+static void chash_leave(CHashTable *table, int reader, unsigned long e)
+{
+  atomic_fetch_sub_explicit(&table->readers[reader].count[e % 3], 1,
+                            memory_order_release);
+}
+
+/* chash_buckets_new (fonction interne) -- alloue un tableau de n paniers
+ * vides (n puissance de 2).
+ * Complexité: O(n)
+ */
+static CHashBuckets *chash_buckets_new(unsigned int n)
+{
+  CHashBuckets *tmp;
+  unsigned int i;
+
+  if ((tmp = (CHashBuckets *) malloc(sizeof(CHashBuckets) +
+                                     n*sizeof(_Atomic(CHashNode *)))) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "chash_buckets_new: erreur d'allocation mémoire.\n");
+#endif
+    return NULL;
+  }
+  tmp->mask = n - 1;
+  tmp->retired = NULL;
+  for (i = 0; i < n; i++)
+    atomic_init(&tmp->heads[i], NULL);
+  return tmp;
+}
+
+/* chash_free_nodes (fonction interne) -- libère une liste de noeuds
+ * chainés par leur champ retired.
+ * Complexité: O(longueur de la liste)
+ */
+static void chash_free_nodes(CHashNode *n)
+{
+  CHashNode *next;
+
+  for (; n != NULL; n = next) {
+    next = n->retired;
+    free(n);
+  }
+}
+
+/* chash_free_buckets (fonction interne) -- libère une liste de tableaux
+ * de paniers chainés par leur champ retired (mais pas leurs noeuds).
+ * Complexité: O(longueur de la liste)
+ */
+static void chash_free_buckets(CHashBuckets *b)
+{
+  CHashBuckets *next;
+
+  for (; b != NULL; b = next) {
+    next = b->retired;
+    free(b);
+  }
+}
+
+/* chash_table_new -- crée une table concurrente pouvant contenir
+ * max_size clés avant de devoir s'agrandir.
+ * Retourne un pointeur sur cette table, ou NULL en cas d'échec.
+ * Complexité: O(max_size)
+ */
+CHashTable *chash_table_new(int max_size, int (*h)(void *),
+                            int (*kequal)(void *, void *))
+{
+  CHashTable *tmp;
+  CHashBuckets *b;
+  unsigned int n;
+  int i, j;
+
+  if ((max_size <= 0) || (h == NULL) || (kequal == NULL))
+    return NULL;
+  /* Au moins un panier par verrou: les noeuds d'un meme panier sont
+   * alors tous protégés par le meme verrou.
+   */
+  for (n = CHASH_STRIPES; n < (unsigned int) max_size; n *= 2)
+    ;
+  if ((tmp = (CHashTable *) malloc(sizeof(CHashTable))) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "chash_table_new: erreur d'allocation mémoire.\n");
+#endif
+    return NULL;
+  }
+  tmp->stripes = NULL;
+  tmp->readers = NULL;
+  if (((b = chash_buckets_new(n)) == NULL) ||
+      (posix_memalign((void **) &tmp->stripes, CHASH_CACHE_LINE,
+                      CHASH_STRIPES*sizeof(CHashStripe)) != 0) ||
+      (posix_memalign((void **) &tmp->readers, CHASH_CACHE_LINE,
+                      CHASH_READERS*sizeof(CHashReaders)) != 0)) {
+#ifdef DEBUG
+    fprintf(stderr, "chash_table_new: erreur d'allocation mémoire.\n");
+#endif
+    free(b);
+    free(tmp->stripes);
+    free(tmp);
+    return NULL;
+  }
+  for (i = 0; i < CHASH_STRIPES; i++)
+    pthread_mutex_init(&tmp->stripes[i].lock, NULL);
+  for (i = 0; i < CHASH_READERS; i++)
+    for (j = 0; j < 3; j++)
+      atomic_init(&tmp->readers[i].count[j], 0);
+  for (j = 0; j < 3; j++) {
+    tmp->retired[j] = NULL;
+    tmp->retired_buckets[j] = NULL;
+  }
+  pthread_mutex_init(&tmp->reclaim, NULL);
+  atomic_init(&tmp->epoch, 0);
+  tmp->nretired = 0;
+  tmp->h = h;
+  tmp->kequal = kequal;
+  atomic_init(&tmp->buckets, b);
+  atomic_init(&tmp->size, 0);
+  return tmp;
+}
+
+/* chash_table_free -- détruit une table et libère la mémoire qu'elle
+ * occupait (mais pas celle des clés et des données). Aucun autre thread
+ * ne doit plus l'utiliser.
+ * Complexité: O(chash_table_max_size(table) + chash_table_size(table))
+ */
+void chash_table_free(CHashTable *table)
+{
+  CHashBuckets *b;
+  CHashNode *n, *next;
+  unsigned int i;
+  int j;
+
+  if (table == NULL)
+    return;
+  b = atomic_load(&table->buckets);
+  for (i = 0; i <= b->mask; i++)
+    for (n = atomic_load(&b->heads[i]); n != NULL; n = next) {
+      next = atomic_load(&n->next);
+      free(n);
+    }
+  free(b);
+  for (j = 0; j < 3; j++) {
+    chash_free_nodes(table->retired[j]);
+    chash_free_buckets(table->retired_buckets[j]);
+  }
+  for (j = 0; j < CHASH_STRIPES; j++)
+    pthread_mutex_destroy(&table->stripes[j].lock);
+  pthread_mutex_destroy(&table->reclaim);
+  free(table->stripes);
+  free(table->readers);
+  free(table);
+}
+
+/* chash_advance (fonction interne) -- passe à l'époque suivante si plus
+ * aucun lecteur n'est annoncé dans l'époque précédente. Les noeuds et
+ * tableaux retirés pendant celle-ci ne sont alors plus visibles de
+ * personne et sont libérés.
+ * Doit etre appelée avec le verrou reclaim.
+ * Complexité: O(CHASH_READERS + nombre d'éléments libérés)
+ */
+static void chash_advance(CHashTable *table)
+{
+  unsigned long e = atomic_load(&table->epoch);
+  int old = (e + 2) % 3;        /* (e - 1) % 3 */
+  int i;
+
+  for (i = 0; i < CHASH_READERS; i++)
+    if (atomic_load(&table->readers[i].count[old]) != 0)
+      return;
+  chash_free_nodes(table->retired[old]);
+  chash_free_buckets(table->retired_buckets[old]);
+  table->retired[old] = NULL;
+  table->retired_buckets[old] = NULL;
+  atomic_store(&table->epoch, e + 1);
+}
+
+/* chash_retire (fonction interne) -- met de coté une liste de noeuds
+ * (chainés par leur champ retired, de first à last) et éventuellement un
+ * tableau de paniers qui ne sont plus accessibles depuis la table, mais
+ * peuvent encore etre lus par d'autres threads.
+ * Complexité: O(1) amortie
+ */
+static void chash_retire(CHashTable *table, CHashNode *first, CHashNode *last,
+                         int count, CHashBuckets *b)
+{
+  int e;
+
+  pthread_mutex_lock(&table->reclaim);
+  e = atomic_load(&table->epoch) % 3;
+  if (first != NULL) {
+    last->retired = table->retired[e];
+    table->retired[e] = first;
+  }
+  if (b != NULL) {
+    b->retired = table->retired_buckets[e];
+    table->retired_buckets[e] = b;
+  }
+  table->nretired += count;
+  if (table->nretired >= CHASH_RECLAIM) {
+    table->nretired = 0;
+    chash_advance(table);
+  }
+  pthread_mutex_unlock(&table->reclaim);
+}
+
+/* chash_grow (fonction interne) -- double le nombre de paniers si la
+ * table contient plus de clés que de paniers. Les noeuds sont recopiés
+ * dans le nouveau tableau; l'ancien tableau et ses noeuds restent
+ * intacts pour les lecteurs en cours, puis sont retirés.
+ * Si l'allocation échoue, la table garde sa taille actuelle.
+ * Complexité: O(chash_table_size(table))
+ */
+static void chash_grow(CHashTable *table)
+{
+  CHashBuckets *b, *nb, *old = NULL;
+  CHashNode *n, *copy, *first = NULL, *last = NULL;
+  unsigned int i, k;
+  int count = 0;
+
+  for (i = 0; i < CHASH_STRIPES; i++)
+    pthread_mutex_lock(&table->stripes[i].lock);
+  b = atomic_load_explicit(&table->buckets, memory_order_relaxed);
+  if (((unsigned int) atomic_load(&table->size) <= b->mask + 1) ||
+      ((nb = chash_buckets_new(2*(b->mask + 1))) == NULL))
+    goto unlock;
+  for (i = 0; i <= b->mask; i++)
+    for (n = atomic_load_explicit(&b->heads[i], memory_order_relaxed);
+         n != NULL; n = atomic_load_explicit(&n->next, memory_order_relaxed)) {
+      if ((copy = (CHashNode *) malloc(sizeof(CHashNode))) == NULL) {
+#ifdef DEBUG
+        fprintf(stderr, "chash_grow: erreur d'allocation mémoire.\n");
+#endif
+        /* Abandonne: le nouveau tableau n'a encore été vu par personne */
+        for (k = 0; k <= nb->mask; k++)
+          for (n = atomic_load(&nb->heads[k]); n != NULL; n = copy) {
+            copy = atomic_load(&n->next);
+            free(n);
+          }
+        free(nb);
+        goto unlock;
+      }
+      copy->key = n->key;
+      copy->item = n->item;
+      k = hash_mix32((uint32_t) table->h(n->key)) & nb->mask;
+      atomic_init(&copy->next, atomic_load_explicit(&nb->heads[k], memory_order_relaxed));
+      atomic_store_explicit(&nb->heads[k], copy, memory_order_relaxed);
+      /* Chaine l'original parmi les noeuds à retirer */
+      n->retired = NULL;
+      if (last == NULL)
+        first = n;
+      else
+        last->retired = n;
+      last = n;
+      count++;
+    }
+  atomic_store_explicit(&table->buckets, nb, memory_order_release);
+  old = b;
+ unlock:
+  for (i = 0; i < CHASH_STRIPES; i++)
+    pthread_mutex_unlock(&table->stripes[i].lock);
+  if (old != NULL)
+    chash_retire(table, first, last, count, old);
+}
+
+/* chash_table_insert -- associe item à key.
+ * La valeur de retour indique si l'insertion s'est faite (0 si key
+ * était déjà présente ou en cas d'erreur d'allocation mémoire).
+ * Complexité: O(1) en moyenne (O(chash_table_size(table)) quand la table
+ * s'agrandit)
+ */
+int chash_table_insert(CHashTable *table, void *key, void *item)
+{
+  CHashBuckets *b;
+  CHashNode *n, *tmp;
+  unsigned int hash, nbuckets;
+  pthread_mutex_t *lock;
+
+  if ((table == NULL) || (key == NULL) || (item == NULL))
+    return 0;
+  if ((tmp = (CHashNode *) malloc(sizeof(CHashNode))) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "chash_table_insert: erreur d'allocation mémoire.\n");
+#endif
+    return 0;
+  }
+  hash = hash_mix32((uint32_t) table->h(key));
+  lock = &table->stripes[hash % CHASH_STRIPES].lock;
+  pthread_mutex_lock(lock);
+  /* Tant qu'on tient le verrou, ni le tableau ni ce panier ne changent */
+  b = atomic_load_explicit(&table->buckets, memory_order_relaxed);
+  for (n = atomic_load_explicit(&b->heads[hash & b->mask], memory_order_relaxed);
+       n != NULL; n = atomic_load_explicit(&n->next, memory_order_relaxed))
+    if (table->kequal(n->key, key)) {
+      pthread_mutex_unlock(lock);
+      free(tmp);
+      return 0;
+    }
+  tmp->key = key;
+  tmp->item = item;
+  atomic_init(&tmp->next, atomic_load_explicit(&b->heads[hash & b->mask],
+                                               memory_order_relaxed));
+  /* Publie le noeud complètement initialisé */
+  atomic_store_explicit(&b->heads[hash & b->mask], tmp, memory_order_release);
+  /* b peut etre libéré dès qu'on lache le verrou: on n'en garde que la
+   * taille.
+   */
+  nbuckets = b->mask + 1;
+  pthread_mutex_unlock(lock);
+  if ((unsigned int) (atomic_fetch_add(&table->size, 1) + 1) > nbuckets)
+    chash_grow(table);
+  return 1;
+}
+
+/* chash_table_remove -- retire key de la table.
+ * La valeur de retour indique si key était présente.
+ * Complexité: O(1) en moyenne
+ */
+int chash_table_remove(CHashTable *table, void *key)
+{
+  CHashBuckets *b;
+  CHashNode *n;
+  _Atomic(CHashNode *) *prev;
+  unsigned int hash;
+  pthread_mutex_t *lock;
+
+  if ((table == NULL) || (key == NULL))
+    return 0;
+  hash = hash_mix32((uint32_t) table->h(key));
+  lock = &table->stripes[hash % CHASH_STRIPES].lock;
+  pthread_mutex_lock(lock);
+  b = atomic_load_explicit(&table->buckets, memory_order_relaxed);
+  for (prev = &b->heads[hash & b->mask];
+       (n = atomic_load_explicit(prev, memory_order_relaxed)) != NULL;
+       prev = &n->next)
+    if (table->kequal(n->key, key))
+      break;
+  if (n == NULL) {
+    pthread_mutex_unlock(lock);
+    return 0;
+  }
+  /* Les lecteurs déjà sur n continuent normalement vers la suite */
+  atomic_store_explicit(prev, atomic_load_explicit(&n->next, memory_order_relaxed),
+                        memory_order_release);
+  pthread_mutex_unlock(lock);
+  atomic_fetch_sub(&table->size, 1);
+  chash_retire(table, n, n, 1, NULL);
+  return 1;
+}
+
+/* chash_table_find -- renvoie la donnée associée à key, ou NULL si key
+ * n'est pas dans la table. Ne prend aucun verrou.
+ * Complexité: O(1) en moyenne
+ */
+void *chash_table_find(CHashTable *table, void *key)
+{
+  CHashBuckets *b;
+  CHashNode *n;
+  void *item = NULL;
+  unsigned int hash;
+  unsigned long e;
+  int reader;
+
+  if ((table == NULL) || (key == NULL))
+    return NULL;
+  hash = hash_mix32((uint32_t) table->h(key));
+  reader = chash_reader();
+  e = chash_enter(table, reader);
+  b = atomic_load_explicit(&table->buckets, memory_order_acquire);
+  for (n = atomic_load_explicit(&b->heads[hash & b->mask], memory_order_acquire);
+       n != NULL; n = atomic_load_explicit(&n->next, memory_order_acquire))
+    if (table->kequal(n->key, key)) {
+      item = n->item;
+      break;
+    }
+  chash_leave(table, reader, e);
+  return item;
+}
+
+/* chash_table_max_size -- renvoie le nombre de paniers de la table.
+ * Complexité: O(1)
+ */
+int chash_table_max_size(CHashTable *table)
+{
+  unsigned long e;
+  int reader, n;
+
+  if (table == NULL)
+    return 0;
+  /* Le tableau pourrait etre retiré pendant qu'on le lit */
+  reader = chash_reader();
+  e = chash_enter(table, reader);
+  n = (int) (atomic_load(&table->buckets)->mask + 1);
+  chash_leave(table, reader, e);
+  return n;
+}
+
+/* chash_table_size -- renvoie le nombre de clés de la table. En présence
+ * d'autres threads, la valeur peut etre périmée dès son retour.
+ * Complexité: O(1)
+ */
+int chash_table_size(CHashTable *table)
+{
+  return (table == NULL) ? 0 : atomic_load(&table->size);
+}
+
+/* chash_table_empty -- détermine si la table est vide.
+ * Complexité: O(1)
+ */
+int chash_table_empty(CHashTable *table)
+{
+  return (chash_table_size(table) == 0);
+}
@@ -0,0 +1,123 @@
+#ifndef CHASH_H
+#define CHASH_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+/* Table de hachage concurrente.
+ * Les lectures (chash_table_find) ne prennent aucun verrou: elles
+ * parcourent les listes de collision pendant que d'autres threads les
+ * modifient. Les écritures prennent l'un des CHASH_STRIPES verrous,
+ * choisi d'après le code de hachage de la clé: deux écritures ne se
+ * gènent que si leurs clés tombent sur le meme verrou.
+ *
+ * Un noeud retiré de la table peut encore etre en cours de lecture par
+ * un autre thread; il n'est donc pas libéré tout de suite mais mis de
+ * coté jusqu'à ce que tous les lecteurs qui pouvaient le voir aient
+ * terminé (reclamation par époques, voir Fraser, "Practical
+ * Lock-Freedom", 2004). Chaque lecteur s'annonce dans l'un des
+ * CHASH_READERS compteurs de l'époque courante; l'époque n'avance que
+ * lorsque plus personne n'est annoncé dans la précédente, et les noeuds
+ * retirés deux époques plus tot sont alors libérés.
+ *
+ * Quand la table contient plus de clés que de paniers, un tableau deux
+ * fois plus grand est construit (avec une copie de chaque noeud, pour ne
+ * pas perturber les lecteurs en cours) sous la protection de tous les
+ * verrous, puis publié d'un coup.
+ *
+ * Comme pour HashTable, h convertit une clé en entier et kequal compare
+ * deux clés; ni les clés ni les données ne peuvent etre NULL.
+ */
+
+#define CHASH_CACHE_LINE 64
+#define CHASH_STRIPES 64        /* Nombre de verrous d'écriture */
+#define CHASH_READERS 64        /* Nombre de compteurs de lecteurs */
+#define CHASH_RECLAIM 64        /* Noeuds retirés avant d'avancer l'époque */
+
+typedef struct _chash_node {
+  void *key;
+  void *item;
+  _Atomic(struct _chash_node *) next;
+  struct _chash_node *retired;  /* Chainage des noeuds retirés */
+} CHashNode;
+
+typedef struct _chash_buckets {
+  unsigned int mask;            /* Nombre de paniers - 1 */
+  struct _chash_buckets *retired; /* Chainage des tableaux retirés */
+  _Atomic(CHashNode *) heads[];
+} CHashBuckets;
+
+typedef struct {
+  _Alignas(CHASH_CACHE_LINE) pthread_mutex_t lock;
+} CHashStripe;
+
+typedef struct {
+  _Alignas(CHASH_CACHE_LINE) atomic_long count[3]; /* Lecteurs par époque */
+} CHashReaders;
+
+typedef struct {
+  int (*h)(void *);             /* Convertit une clé en entier */
+  int (*kequal)(void *, void *); /* Prédicat de comparaison de clés */
+  _Atomic(CHashBuckets *) buckets; /* Tableau de paniers courant */
+  atomic_int size;              /* Nombre de clés */
+  CHashStripe *stripes;         /* Verrous d'écriture */
+  CHashReaders *readers;        /* Compteurs de lecteurs */
+  pthread_mutex_t reclaim;      /* Protège ce qui suit */
+  atomic_ulong epoch;           /* Époque courante */
+  int nretired;                 /* Noeuds retirés depuis le dernier essai */
+  CHashNode *retired[3];        /* Noeuds retirés, par époque */
+  CHashBuckets *retired_buckets[3]; /* Tableaux retirés, par époque */
+} CHashTable;
+
+/* chash_table_new -- crée une table concurrente pouvant contenir
+ * max_size clés avant de devoir s'agrandir.
+ * Retourne un pointeur sur cette table, ou NULL en cas d'échec.
+ * Complexité: O(max_size)
+ */
+extern CHashTable *chash_table_new(int max_size, int (*h)(void *),
+                                   int (*kequal)(void *, void *));
+
+/* chash_table_free -- détruit une table et libère la mémoire qu'elle
+ * occupait (mais pas celle des clés et des données). Aucun autre thread
+ * ne doit plus l'utiliser.
+ * Complexité: O(chash_table_max_size(table) + chash_table_size(table))
+ */
+extern void chash_table_free(CHashTable *table);
+
+/* chash_table_insert -- associe item à key.
+ * La valeur de retour indique si l'insertion s'est faite (0 si key
+ * était déjà présente ou en cas d'erreur d'allocation mémoire).
+ * Complexité: O(1) en moyenne (O(chash_table_size(table)) quand la table
+ * s'agrandit)
+ */
+extern int chash_table_insert(CHashTable *table, void *key, void *item);
+
+/* chash_table_remove -- retire key de la table.
+ * La valeur de retour indique si key était présente.
+ * Complexité: O(1) en moyenne
+ */
+extern int chash_table_remove(CHashTable *table, void *key);
+
+/* chash_table_find -- renvoie la donnée associée à key, ou NULL si key
+ * n'est pas dans la table. Ne prend aucun verrou.
+ * Complexité: O(1) en moyenne
+ */
+extern void *chash_table_find(CHashTable *table, void *key);
+
+/* chash_table_max_size -- renvoie le nombre de paniers de la table.
+ * Complexité: O(1)
+ */
+extern int chash_table_max_size(CHashTable *table);
+
+/* chash_table_size -- renvoie le nombre de clés de la table. En présence
+ * d'autres threads, la valeur peut etre périmée dès son retour.
+ * Complexité: O(1)
+ */
+extern int chash_table_size(CHashTable *table);
+
+/* chash_table_empty -- détermine si la table est vide.
+ * Complexité: O(1)
+ */
+extern int chash_table_empty(CHashTable *table);
+
+#endif /* CHASH_H */
@@ -5,7 +5,8 @@
 #include "dsets.h"
 
 /* dsets_new -- crée une nouvelle collection d'ensembles disjoints
- * de size entiers (entre 0 et size - 1).
+ * de size entiers (entre 0 et size - 1). Chaque entier forme d'abord un
+ * ensemble à lui seul.
  * Renvoie un pointeur sur cette nouvelle collection, ou NULL
  * si la création n'a pas pu se faire.
  * Complexité: O(size)
@@ -20,31 +21,28 @@ DSets *dsets_new(int size)
 #ifdef DEBUG
     fprintf(stderr, "dsets_new: erreur d'allocation mémoire.\n");
 #endif
-    return 0;
-  }
-
-  if ((tmp->father = (int *) malloc(size*sizeof(int))) == NULL) {
-#ifdef DEBUG
-    fprintf(stderr, "dsets_new: erreur d'allocation mémoire.\n");
-#endif
-    free(tmp);
     return NULL;
   }
 
-  if ((tmp->rank = (int *) malloc(size*sizeof(int))) == NULL) {
+  tmp->parent = (int *) malloc(size*sizeof(int));
+  tmp->next = (int *) malloc(size*sizeof(int));
+  if ((tmp->parent == NULL) || (tmp->next == NULL)) {
 #ifdef DEBUG
     fprintf(stderr, "dsets_new: erreur d'allocation mémoire.\n");
 #endif
+    free(tmp->parent);
+    free(tmp->next);
+    free(tmp);
     return NULL;
   }
 
   tmp->size = size;
+  tmp->count = size;
   for (i = 0; i < size; i++) {
-    tmp->father[i] = -1;
-    tmp->rank[i] = 0;
+    tmp->parent[i] = -1;
+    tmp->next[i] = i;
   }
   return tmp;
-
 }
 
 /* dsets_free -- détruit une collection d'ensembles et libère la
@@ -54,8 +52,8 @@ DSets *dsets_new(int size)
 void dsets_free(DSets *ds)
 {
   assert(ds != NULL);
-  if (ds->father != NULL) free(ds->father);
-  if (ds->rank != NULL) free(ds->rank);
+  free(ds->parent);
+  free(ds->next);
   free(ds);
 }
 
@@ -69,67 +67,89 @@ int dsets_max_size(DSets *ds)
   return ds->size;
 }
 
+/* dsets_count -- renvoie le nombre d'ensembles de la collection.
+ * Complexité: O(1)
+ */
+int dsets_count(DSets *ds)
+{
+  assert(ds != NULL);
+  return ds->count;
+}
+
 /* dsets_make_set -- crée un nouvel ensemble ne contenant que l'élément n
- * dans la collection ds.
+ * dans la collection ds. Les éléments sont des singletons dès la
+ * création de la collection: cette fonction ne fait rien si n est déjà
+ * seul dans son ensemble, et n'est gardée que pour la compatibilité.
+ * Elle ne doit pas etre appelée sur un élément d'un ensemble plus grand.
  * Complexité: O(1)
  */
 void dsets_make_set(DSets *ds, int n)
 {
-  assert((ds != NULL) && (ds->father != NULL) && (ds->rank != NULL) && (n >= 0));
-  if (n > ds->size) return;
-  ds->father[n] = n;
-  ds->rank[n] = 0;
+  assert((ds != NULL) && (ds->parent != NULL) && (n >= 0));
+  if (n >= ds->size) return;
+  assert(ds->parent[n] == -1);
 }
 
 /* dsets_find_set -- renvoie le représentant de l'ensemble auquel n appartient
  * dans ds.
- * Renvoie -1 si n n'est dans aucun ensemble.
+ * Renvoie -1 si n n'est pas un élément de ds.
+ * Complexité: O(α(dsets_max_size(ds))) amortie
  */
 int dsets_find_set(DSets *ds, int n)
 {
-  assert((ds != NULL) && (ds->father != NULL) && (n >= 0));
-  if (n > ds->size) return -1;
-
-  while ((ds->father[ds->father[n]] != ds->father[n]) && (ds->father[n] != -1)) {
-    ds->father[n] = ds->father[ds->father[n]],
-    n = ds->father[ds->father[n]];
+  int *parent;
+
+  assert((ds != NULL) && (ds->parent != NULL));
+  if ((n < 0) || (n >= ds->size)) return -1;
+  parent = ds->parent;
+  while (parent[n] >= 0) {
+    /* Path halving: n saute à son grand-père, qu'il prend pour père */
+    if (parent[parent[n]] >= 0)
+      parent[n] = parent[parent[n]];
+    n = parent[n];
   }
-  return ds->father[n];
+  return n;
 }
 
-/* dsets_union -- réuni les ensembles contenant n1 et n2
- * Complexité: O(ln(dsets_max_size(ds)))
+/* dsets_union -- réuni les ensembles contenant n1 et n2.
+ * La valeur de retour indique si deux ensembles ont été réunis (0 si n1
+ * et n2 étaient déjà dans le meme ensemble, ou si l'un d'eux n'est pas un
+ * élément de ds).
+ * Complexité: O(α(dsets_max_size(ds))) amortie
  */
-void dsets_union(DSets *ds, int n1, int n2)
+int dsets_union(DSets *ds, int n1, int n2)
 {
-  int father, son;
+  int tmp;
 
-  assert((ds != NULL) && (ds->father != NULL) && (n1 >= 0) && (n2 >= 0));
-  if ((n1 > ds->size) || (n2 > ds->size)) return;
+  assert((ds != NULL) && (ds->parent != NULL));
   n1 = dsets_find_set(ds, n1);
   n2 = dsets_find_set(ds, n2);
-  if ((n1 == -1) || (n2 == -1)) return;
-
-  if (ds->rank[n1] > ds->rank[n2]) {
-    father = n1;
-    son = n2;
-  } else {
-    father = n2;
-    son = n1;
+  if ((n1 == -1) || (n2 == -1) || (n1 == n2)) return 0;
+
+  /* n1 devient la racine du plus grand ensemble (tailles négatives) */
+  if (ds->parent[n1] > ds->parent[n2]) {
+    tmp = n1;
+    n1 = n2;
+    n2 = tmp;
   }
-  ds->father[son] = father;
-  if (ds->rank[n1] == ds->rank[n2])
-    ds->rank[father] += 1;
+  ds->parent[n1] += ds->parent[n2];
+  ds->parent[n2] = n1;
+  /* Raccorde les deux anneaux */
+  tmp = ds->next[n1];
+  ds->next[n1] = ds->next[n2];
+  ds->next[n2] = tmp;
+  ds->count -= 1;
+  return 1;
 }
 
 /* dsets_same_set -- détermine si n1 et n2 font parti du meme ensemble
+ * Complexité: O(α(dsets_max_size(ds))) amortie
  */
 int dsets_same_set(DSets *ds, int n1, int n2)
 {
   int i;
   int j;
-  assert((ds != NULL) && (ds->father != NULL) &&
-         (ds->rank != NULL) && (n1 >= 0) && (n2 >= 0));
+  assert((ds != NULL) && (ds->parent != NULL));
   i = dsets_find_set(ds, n1);
   j = dsets_find_set(ds, n2);
   if ((i == -1) || (j == -1))
@@ -138,7 +158,68 @@ int dsets_same_set(DSets *ds, int n1, int n2)
     return (i == j);
 }
 
-/* dsets_print -- affiche la liste des éléments de ds et de leurs pères
+/* dsets_set_size -- renvoie le nombre d'éléments de l'ensemble auquel n
+ * appartient, ou 0 si n n'est pas un élément de ds.
+ * Complexité: O(α(dsets_max_size(ds))) amortie
+ */
+int dsets_set_size(DSets *ds, int n)
+{
+  assert(ds != NULL);
+  if ((n = dsets_find_set(ds, n)) == -1) return 0;
+  return -ds->parent[n];
+}
+
+/* dsets_next_member -- renvoie l'élément qui suit n dans l'anneau de son
+ * ensemble (n lui-meme s'il est seul), ou -1 si n n'est pas un élément de
+ * ds. En partant de n et en suivant les dsets_next_member jusqu'à
+ * revenir à n, on visite chaque élément de l'ensemble une fois.
+ * Complexité: O(1)
+ */
+int dsets_next_member(DSets *ds, int n)
+{
+  assert((ds != NULL) && (ds->next != NULL));
+  if ((n < 0) || (n >= ds->size)) return -1;
+  return ds->next[n];
+}
+
+/* dsets_set_members -- range dans out les éléments de l'ensemble auquel
+ * n appartient, en commençant par n, et renvoie leur nombre (0 si n
+ * n'est pas un élément de ds). out doit pouvoir contenir
+ * dsets_set_size(ds, n) entiers.
+ * Complexité: O(dsets_set_size(ds, n))
+ */
+int dsets_set_members(DSets *ds, int n, int *out)
+{
+  int m, count = 0;
+
+  assert((ds != NULL) && (ds->next != NULL) && (out != NULL));
+  if ((n < 0) || (n >= ds->size)) return 0;
+  m = n;
+  do {
+    out[count++] = m;
+    m = ds->next[m];
+  } while (m != n);
+  return count;
+}
+
+/* dsets_roots -- range dans out les représentants de tous les ensembles,
+ * par ordre croissant, et renvoie leur nombre. out doit pouvoir contenir
+ * dsets_count(ds) entiers.
+ * Complexité: O(dsets_max_size(ds))
+ */
+int dsets_roots(DSets *ds, int *out)
+{
+  int i, count = 0;
+
+  assert((ds != NULL) && (ds->parent != NULL) && (out != NULL));
+  for (i = 0; i < ds->size; i++)
+    if (ds->parent[i] < 0)
+      out[count++] = i;
+  return count;
+}
+
+/* dsets_print -- affiche la liste des éléments de ds et de leurs
+ * représentants
  */
 void dsets_print(DSets *ds)
 {
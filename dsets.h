@@ -1,14 +1,29 @@
 #ifndef DSETS_H
 #define DSETS_H
 
+/* Ensembles disjoints (union-find).
+ * Un seul tableau décrit la foret: parent[n] est le père de n, ou, si n
+ * est la racine (le représentant) de son ensemble, l'opposé du nombre
+ * d'éléments de cet ensemble. Une recherche ne lit donc qu'une case par
+ * élément visité; elle raccourcit le chemin au passage en faisant
+ * pointer chaque élément sur son grand-père (path halving). L'union
+ * rattache le plus petit ensemble au plus grand.
+ *
+ * Les éléments d'un meme ensemble sont de plus chainés en anneau par le
+ * tableau next. Réunir deux ensembles revient à échanger les suivants de
+ * leurs représentants, ce qui raccorde les deux anneaux en O(1); on peut
+ * ensuite énumérer un ensemble en O(taille de l'ensemble).
+ */
 typedef struct {
-  int size;
-  int *father;
-  int *rank;
+  int size;                     /* Nombre d'éléments */
+  int count;                    /* Nombre d'ensembles */
+  int *parent;                  /* Père, ou -taille de l'ensemble à la racine */
+  int *next;                    /* Elément suivant dans l'anneau de l'ensemble */
 } DSets;
 
 /* dsets_new -- crée une nouvelle collection d'ensembles disjoints
- * de size entiers (entre 0 et size - 1).
+ * de size entiers (entre 0 et size - 1). Chaque entier forme d'abord un
+ * ensemble à lui seul.
  * Renvoie un pointeur sur cette nouvelle collection, ou NULL
  * si la création n'a pas pu se faire.
  * Complexité: O(size)
@@ -27,28 +42,71 @@ extern void dsets_free(DSets *ds);
  */
 extern int dsets_max_size(DSets *ds);
 
+/* dsets_count -- renvoie le nombre d'ensembles de la collection.
+ * Complexité: O(1)
+ */
+extern int dsets_count(DSets *ds);
+
 /* dsets_make_set -- crée un nouvel ensemble ne contenant que l'élément n
- * dans la collection ds.
+ * dans la collection ds. Les éléments sont des singletons dès la
+ * création de la collection: cette fonction ne fait rien si n est déjà
+ * seul dans son ensemble, et n'est gardée que pour la compatibilité.
+ * Elle ne doit pas etre appelée sur un élément d'un ensemble plus grand.
  * Complexité: O(1)
  */
 extern void dsets_make_set(DSets *ds, int n);
 
 /* dsets_find_set -- renvoie le représentant de l'ensemble auquel n appartient
  * dans ds.
- * Renvoie -1 si n n'est dans aucun ensemble.
+ * Renvoie -1 si n n'est pas un élément de ds.
+ * Complexité: O(α(dsets_max_size(ds))) amortie
  */
 extern int dsets_find_set(DSets *ds, int n);
 
-/* dsets_union -- réuni les ensembles contenant n1 et n2
- * Complexité: O(ln(dsets_max_size(ds)))
+/* dsets_union -- réuni les ensembles contenant n1 et n2.
+ * La valeur de retour indique si deux ensembles ont été réunis (0 si n1
+ * et n2 étaient déjà dans le meme ensemble, ou si l'un d'eux n'est pas un
+ * élément de ds).
+ * Complexité: O(α(dsets_max_size(ds))) amortie
  */
-extern void dsets_union(DSets *ds, int n1, int n2);
+extern int dsets_union(DSets *ds, int n1, int n2);
 
 /* dsets_same_set -- détermine si n1 et n2 font parti du meme ensemble
+ * Complexité: O(α(dsets_max_size(ds))) amortie
  */
 extern int dsets_same_set(DSets *ds, int n1, int n2);
 
-/* dsets_print -- affiche la liste des éléments de ds et de leurs pères
+/* dsets_set_size -- renvoie le nombre d'éléments de l'ensemble auquel n
+ * appartient, ou 0 si n n'est pas un élément de ds.
+ * Complexité: O(α(dsets_max_size(ds))) amortie
+ */
+extern int dsets_set_size(DSets *ds, int n);
+
+/* dsets_next_member -- renvoie l'élément qui suit n dans l'anneau de son
+ * ensemble (n lui-meme s'il est seul), ou -1 si n n'est pas un élément de
+ * ds. En partant de n et en suivant les dsets_next_member jusqu'à
+ * revenir à n, on visite chaque élément de l'ensemble une fois.
+ * Complexité: O(1)
+ */
+extern int dsets_next_member(DSets *ds, int n);
+
+/* dsets_set_members -- range dans out les éléments de l'ensemble auquel
+ * n appartient, en commençant par n, et renvoie leur nombre (0 si n
+ * n'est pas un élément de ds). out doit pouvoir contenir
+ * dsets_set_size(ds, n) entiers.
+ * Complexité: O(dsets_set_size(ds, n))
+ */
+extern int dsets_set_members(DSets *ds, int n, int *out);
+
+/* dsets_roots -- range dans out les représentants de tous les ensembles,
+ * par ordre croissant, et renvoie leur nombre. out doit pouvoir contenir
+ * dsets_count(ds) entiers.
+ * Complexité: O(dsets_max_size(ds))
+ */
+extern int dsets_roots(DSets *ds, int *out);
+
+/* dsets_print -- affiche la liste des éléments de ds et de leurs
+ * représentants
  */
 extern void dsets_print(DSets *ds);
 
@@ -73,14 +73,13 @@ void edge_set_attr(Edge *e, int attr)
   e->attr = attr;
 }
     
-/* edge_print -- affiche les informations contenues dans e.
+/* edge_print_attr (fonction interne) -- affiche le nom de la couleur
+ * attr.
  * Complexité: O(1)
  */
-void edge_print(Edge *e)
+static void edge_print_attr(int attr)
 {
-  assert(e != NULL);
-  printf("%d --(%02d)--> %d\t", e->v1, (int) e->weight, e->v2);
-  switch (e->attr) {
+  switch (attr) {
   case WHITE:
     printf("Blanc");
     break;
@@ -97,6 +96,27 @@ void edge_print(Edge *e)
     printf("Rouge");
     break;
   default:
-    printf("%d", e->attr);
+    printf("%d", attr);
   }
 }
+
+/* edge_print -- affiche les informations contenues dans e.
+ * Complexité: O(1)
+ */
+void edge_print(Edge *e)
+{
+  assert(e != NULL);
+  printf("%d --(%02d)--> %d\t", e->v1, (int) e->weight, e->v2);
+  edge_print_attr(e->attr);
+}
+
+/* edge_print_labels -- comme edge_print, mais désigne les sommets v1 et
+ * v2 de e par leurs noms l1 et l2 plutot que par leurs numéros.
+ * Complexité: O(1)
+ */
+void edge_print_labels(Edge *e, const char *l1, const char *l2)
+{
+  assert((e != NULL) && (l1 != NULL) && (l2 != NULL));
+  printf("%s --(%02d)--> %s\t", l1, (int) e->weight, l2);
+  edge_print_attr(e->attr);
+}
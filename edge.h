@@ -52,4 +52,10 @@ extern void edge_set_attr(Edge *e, int attr);
  */
 extern void edge_print(Edge *e);
 
+/* edge_print_labels -- comme edge_print, mais désigne les sommets v1 et
+ * v2 de e par leurs noms l1 et l2 plutot que par leurs numéros.
+ * Complexité: O(1)
+ */
+extern void edge_print_labels(Edge *e, const char *l1, const char *l2);
+
 #endif /* EDGE_H */
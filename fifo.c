@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 
 #include "fifo.h"
@@ -118,6 +119,91 @@ void *fifo_get(Fifo *fifo)
     return ret;
 }
 
+/* fifo_put_n -- insère dans la file, dans l'ordre, au plus n éléments
+ * du tableau items.
+ * Renvoie le nombre d'éléments effectivement insérés (moins de n si la
+ * file se remplit).
+ * Complexité: O(n)
+ */
+int fifo_put_n(Fifo *fifo, void **items, int n)
+{
+    int room, first;
+
+    assert((fifo != NULL) && (fifo->items != NULL) && (items != NULL) && (n >= 0));
+    room = fifo_max_size(fifo) - fifo_length(fifo);
+    if (n > room) n = room;
+    /* Recopie jusqu'à la fin du tableau, puis depuis le début */
+    first = fifo->max_size - fifo->newest;
+    if (first > n) first = n;
+    memcpy(fifo->items + fifo->newest, items, first*sizeof(void *));
+    memcpy(fifo->items, items + first, (n - first)*sizeof(void *));
+    fifo->newest += n;
+    if (fifo->newest >= fifo->max_size) fifo->newest -= fifo->max_size;
+    return n;
+}
+
+/* fifo_get_n -- retire de la file au plus n éléments et les range dans
+ * out, du plus ancien au plus récent.
+ * Renvoie le nombre d'éléments effectivement retirés.
+ * Complexité: O(n)
+ */
+int fifo_get_n(Fifo *fifo, void **out, int n)
+{
+    void **first, **second;
+    int first_len, second_len, len;
+
+    assert((fifo != NULL) && (out != NULL) && (n >= 0));
+    len = fifo_peek(fifo, &first, &first_len, &second, &second_len);
+    if (n > len) n = len;
+    if (first_len > n) first_len = n;
+    memcpy(out, first, first_len*sizeof(void *));
+    memcpy(out + first_len, second, (n - first_len)*sizeof(void *));
+    return fifo_consume(fifo, n);
+}
+
+/* fifo_peek -- donne accès, sans les recopier ni les retirer, aux
+ * éléments de la file. A cause du retour en début de tableau, ils
+ * occupent au plus deux zones contigues: *first (de longueur *first_len)
+ * puis *second (de longueur *second_len, éventuellement nulle).
+ * Les zones restent valides tant que les éléments ne sont pas retirés;
+ * on peut insérer de nouveaux éléments pendant ce temps.
+ * Renvoie le nombre total d'éléments.
+ * Complexité: O(1)
+ */
+int fifo_peek(Fifo *fifo, void ***first, int *first_len,
+              void ***second, int *second_len)
+{
+    assert((fifo != NULL) && (fifo->items != NULL) && (first != NULL) &&
+           (first_len != NULL) && (second != NULL) && (second_len != NULL));
+    *first = fifo->items + fifo->oldest;
+    *second = fifo->items;
+    if (fifo->newest >= fifo->oldest) {
+        *first_len = fifo->newest - fifo->oldest;
+        *second_len = 0;
+    } else {
+        *first_len = fifo->max_size - fifo->oldest;
+        *second_len = fifo->newest;
+    }
+    return *first_len + *second_len;
+}
+
+/* fifo_consume -- retire de la file ses n plus anciens éléments (par
+ * exemple après les avoir traités en place avec fifo_peek).
+ * Renvoie le nombre d'éléments effectivement retirés.
+ * Complexité: O(1)
+ */
+int fifo_consume(Fifo *fifo, int n)
+{
+    int len;
+
+    assert((fifo != NULL) && (fifo->items != NULL) && (n >= 0));
+    len = fifo_length(fifo);
+    if (n > len) n = len;
+    fifo->oldest += n;
+    if (fifo->oldest >= fifo->max_size) fifo->oldest -= fifo->max_size;
+    return n;
+}
+
 /* fifo_print -- affiche une file à l'écran. Chaque élément est affiché en
  * faisant appel à print_item.
  * Complexité: O(1)
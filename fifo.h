@@ -60,6 +60,40 @@ extern void fifo_put(Fifo *fifo, void *item);
  */
 extern void *fifo_get(Fifo *fifo);
 
+/* fifo_put_n -- insère dans la file, dans l'ordre, au plus n éléments
+ * du tableau items.
+ * Renvoie le nombre d'éléments effectivement insérés (moins de n si la
+ * file se remplit).
+ * Complexité: O(n)
+ */
+extern int fifo_put_n(Fifo *fifo, void **items, int n);
+
+/* fifo_get_n -- retire de la file au plus n éléments et les range dans
+ * out, du plus ancien au plus récent.
+ * Renvoie le nombre d'éléments effectivement retirés.
+ * Complexité: O(n)
+ */
+extern int fifo_get_n(Fifo *fifo, void **out, int n);
+
+/* fifo_peek -- donne accès, sans les recopier ni les retirer, aux
+ * éléments de la file. A cause du retour en début de tableau, ils
+ * occupent au plus deux zones contigues: *first (de longueur *first_len)
+ * puis *second (de longueur *second_len, éventuellement nulle).
+ * Les zones restent valides tant que les éléments ne sont pas retirés;
+ * on peut insérer de nouveaux éléments pendant ce temps.
+ * Renvoie le nombre total d'éléments.
+ * Complexité: O(1)
+ */
+extern int fifo_peek(Fifo *fifo, void ***first, int *first_len,
+                     void ***second, int *second_len);
+
+/* fifo_consume -- retire de la file ses n plus anciens éléments (par
+ * exemple après les avoir traités en place avec fifo_peek).
+ * Renvoie le nombre d'éléments effectivement retirés.
+ * Complexité: O(1)
+ */
+extern int fifo_consume(Fifo *fifo, int n);
+
 /* fifo_print -- affiche une file à l'écran. Chaque élément est affiché en
  * faisant appel à print_item.
  * Complexité: O(1)
@@ -21,7 +21,7 @@ Graph *graph_new(int size)
     return NULL;
   }
   tmp->size = size;
-  if ((tmp->vertex = (Vertex *) malloc(size*sizeof(Edge *))) == NULL) {
+  if ((tmp->vertex = (Vertex *) calloc(size, sizeof(Vertex))) == NULL) {
 #ifdef DEBUG
     fprintf(stderr, "graph_new: erreur d'allocation mémoire.\n");
 #endif
@@ -210,7 +210,7 @@ int graph_add_vertex(Graph *g, int v)
   if (v >= graph_max_size(g)) return 0;
 
   if (g->vertex[v] == NULL) {
-    g->vertex[v] = (Edge **) malloc(g->size*sizeof(Edge *));
+    g->vertex[v] = (Edge **) calloc(g->size, sizeof(Edge *));
     if (g->vertex[v] == NULL) {
 #ifdef DEBUG
       fprintf(stderr, "graph_add_vertex: erreur d'allocation mémoire.\n");
@@ -1,90 +1,320 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include <math.h>
+#include <string.h>
+#include <assert.h>
 
 #include "hash.h"
-#include "slist.h"
 
+/* hash_table_new -- crée une table de hachage d'au moins max_size
+ * paniers (arrondi à la puissance de 2 supérieure). La table
+ * s'agrandit automatiquement quand elle contient plus de clés que de
+ * paniers.
+ * Retourne un pointeur sur cette table, ou NULL en cas d'échec.
+ * Complexité: O(max_size)
+ */
 HashTable *hash_table_new(int max_size, int (*h)(void *), int (*kequal)(void *, void*))
 {
   HashTable *tmp;
+  int n;
 
-  if ((max_size == 0) || (h == NULL) || (kequal == NULL) ||
-      ((tmp = (HashTable *) malloc(sizeof(HashTable))) == NULL) ||
-      ((tmp->items = (SList **) malloc(max_size*sizeof(SList *))) == NULL))
+  if ((max_size <= 0) || (h == NULL) || (kequal == NULL))
     return NULL;
+  for (n = 1; n < max_size; n *= 2)
+    ;
+  max_size = n;
+  if ((tmp = (HashTable *) malloc(sizeof(HashTable))) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "hash_table_new: erreur d'allocation mémoire.\n");
+#endif
+    return NULL;
+  }
+  if (((tmp->items = (HashItem **) calloc(max_size, sizeof(HashItem *))) == NULL) ||
+      ((tmp->pool = pool_new(sizeof(HashItem), HASH_SLAB_ITEMS)) == NULL)) {
+#ifdef DEBUG
+    fprintf(stderr, "hash_table_new: erreur d'allocation mémoire.\n");
+#endif
+    free(tmp->items);
+    free(tmp);
+    return NULL;
+  }
   tmp->max_size = max_size;
   tmp->size = 0;
   tmp->h = h;
   tmp->kequal = kequal;
+  tmp->old_max_size = 0;
+  tmp->migrated = 0;
+  tmp->old_items = NULL;
   return tmp;
 }
 
+/* hash_table_free -- détruit une table et libère la mémoire qu'elle
+ * occupait (mais pas celle des clés et des données).
+ * Complexité: O(nombre de slabs)
+ */
 void hash_table_free(HashTable *table)
 {
-  int i;
-
   if (table == NULL)
     return;
-  if (table->items != NULL) {
-    for (i = 0; i < table->max_size; i++)
-      if (table->items[i] != NULL)
-        slist_free(table->items[i]);
-    free(table->items);
-  }
+  free(table->old_items);
+  free(table->items);
+  pool_free(table->pool);
   free(table);
 }
 
-int hash_table_insert(HashTable *table, void *key, void *item)
+/* hash_table_clear -- retire toutes les clés de la table, qui garde sa
+ * taille et sa mémoire pour etre réutilisée.
+ * Complexité: O(hash_table_max_size(table))
+ */
+void hash_table_clear(HashTable *table)
+{
+  assert(table != NULL);
+  /* Un agrandissement en cours n'a plus rien à migrer */
+  free(table->old_items);
+  table->old_items = NULL;
+  table->old_max_size = 0;
+  table->migrated = 0;
+  memset(table->items, 0, table->max_size*sizeof(HashItem *));
+  pool_clear(table->pool);
+  table->size = 0;
+}
+
+/* hash_table_index (fonction interne) -- renvoie le numéro du panier de
+ * key dans un tableau de n paniers (n puissance de 2).
+ * Complexité: O(1)
+ */
+static int hash_table_index(HashTable *table, void *key, int n)
+{
+  return (int) (hash_mix32((uint32_t) table->h(key)) & (uint32_t) (n - 1));
+}
+
+/* hash_table_bucket (fonction interne) -- renvoie l'adresse du panier
+ * où se trouve (ou devrait se trouver) key: dans l'ancien tableau si le
+ * panier correspondant n'a pas encore été migré, dans le nouveau sinon.
+ * Complexité: O(1)
+ */
+static HashItem **hash_table_bucket(HashTable *table, void *key)
 {
   int k;
+
+  if (table->old_items != NULL) {
+    k = hash_table_index(table, key, table->old_max_size);
+    if (k >= table->migrated)
+      return &table->old_items[k];
+  }
+  return &table->items[hash_table_index(table, key, table->max_size)];
+}
+
+/* hash_table_lookup (fonction interne) -- cherche key dans la liste
+ * commençant en *bucket.
+ * Renvoie l'adresse du pointeur qui désigne l'entrée de key (pour
+ * pouvoir la retirer), ou NULL si key est absente.
+ * Complexité: O(longueur de la liste)
+ */
+static HashItem **hash_table_lookup(HashTable *table, HashItem **bucket, void *key)
+{
+  for (; *bucket != NULL; bucket = &(*bucket)->next)
+    if (table->kequal((*bucket)->key, key))
+      return bucket;
+  return NULL;
+}
+
+/* hash_table_migrate (fonction interne) -- déplace au plus n paniers
+ * de l'ancien tableau vers le nouveau, et libère l'ancien tableau une
+ * fois la migration terminée. Les entrées sont simplement rechainées.
+ * Complexité: O(n) en moyenne
+ */
+static void hash_table_migrate(HashTable *table, int n)
+{
+  HashItem *hi, *next;
+  int k;
+
+  while ((table->old_items != NULL) && (n-- > 0)) {
+    for (hi = table->old_items[table->migrated]; hi != NULL; hi = next) {
+      next = hi->next;
+      k = hash_table_index(table, hi->key, table->max_size);
+      hi->next = table->items[k];
+      table->items[k] = hi;
+    }
+    table->migrated += 1;
+    if (table->migrated == table->old_max_size) {
+      free(table->old_items);
+      table->old_items = NULL;
+      table->old_max_size = 0;
+      table->migrated = 0;
+    }
+  }
+}
+
+/* hash_table_grow (fonction interne) -- alloue un tableau de paniers
+ * deux fois plus grand. Les éléments restent dans l'ancien tableau et
+ * seront déplacés petit à petit par hash_table_migrate.
+ * Si l'allocation échoue, la table garde simplement sa taille actuelle.
+ * Complexité: O(hash_table_max_size(table))
+ */
+static void hash_table_grow(HashTable *table)
+{
+  HashItem **items;
+
+  assert(table->old_items == NULL);
+  if ((items = (HashItem **) calloc(2*table->max_size, sizeof(HashItem *))) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "hash_table_grow: erreur d'allocation mémoire.\n");
+#endif
+    return;
+  }
+  table->old_items = table->items;
+  table->old_max_size = table->max_size;
+  table->migrated = 0;
+  table->items = items;
+  table->max_size *= 2;
+}
+
+/* hash_table_insert -- associe item à key.
+ * La valeur de retour indique si l'insertion s'est faite (0 si key est
+ * déjà présente ou en cas d'erreur d'allocation mémoire).
+ * Complexité: O(1) en moyenne, y compris pendant un agrandissement
+ */
+int hash_table_insert(HashTable *table, void *key, void *item)
+{
+  HashItem **bucket;
   HashItem *tmp;
 
-  if ((key == NULL) || (item == NULL) || hash_table_full(table) ||
-      ((tmp = (HashItem *) malloc(sizeof(HashItem))) == NULL))
+  if ((table == NULL) || (key == NULL) || (item == NULL))
     return 0;
+  hash_table_migrate(table, HASH_MIGRATE_STEP);
+  if (hash_table_lookup(table, hash_table_bucket(table, key), key) != NULL)
+    return 0;
+  /* Un agrandissement ne commence que si le précédent est terminé, ce
+   * qui est toujours le cas en pratique: il faut au moins max_size/2
+   * insertions pour repasser le seuil, et chacune migre
+   * HASH_MIGRATE_STEP paniers.
+   */
+  if ((table->size >= table->max_size) && (table->old_items == NULL))
+    hash_table_grow(table);
 
-  k = table->h(key) % table->max_size;
+  if ((tmp = (HashItem *) pool_alloc(table->pool)) == NULL)
+    return 0;
   tmp->key = key;
   tmp->item = item;
-  if (table->items[k] == NULL)
-    table->items[k] = slist_new();
-
-  return slist_insert(table->items[k], tmp);
+  bucket = hash_table_bucket(table, key);
+  tmp->next = *bucket;
+  *bucket = tmp;
+  table->size += 1;
+  return 1;
 }
 
+/* hash_table_remove -- retire key de la table.
+ * La valeur de retour indique si key était présente.
+ * Complexité: O(1) en moyenne
+ */
 int hash_table_remove(HashTable *table, void *key)
 {
-  int k;
+  HashItem **prev;
+  HashItem *hi;
 
-  if ((key == NULL) || hash_table_full(table))
+  if ((table == NULL) || (key == NULL))
+    return 0;
+  hash_table_migrate(table, HASH_MIGRATE_STEP);
+  if ((prev = hash_table_lookup(table, hash_table_bucket(table, key), key)) == NULL)
     return 0;
-  
-  k = table->h(key) % table->max_size;
-  
+  hi = *prev;
+  *prev = hi->next;
+  pool_release(table->pool, hi);
+  table->size -= 1;
+  return 1;
 }
 
+/* hash_table_find -- renvoie la donnée associée à key, ou NULL si key
+ * n'est pas dans la table.
+ * Complexité: O(1) en moyenne
+ */
 void *hash_table_find(HashTable *table, void *key)
 {
-  return 0;
+  HashItem **hi;
+
+  if ((table == NULL) || (key == NULL))
+    return NULL;
+  hash_table_migrate(table, HASH_MIGRATE_STEP);
+  hi = hash_table_lookup(table, hash_table_bucket(table, key), key);
+  return (hi == NULL) ? NULL : (*hi)->item;
 }
 
+/* hash_table_max_size -- renvoie le nombre de paniers de la table.
+ * Complexité: O(1)
+ */
 int hash_table_max_size(HashTable *table)
 {
   return (table == NULL) ? 0 : table->max_size;
 }
 
+/* hash_table_size -- renvoie le nombre de clés de la table.
+ * Complexité: O(1)
+ */
 int hash_table_size(HashTable *table)
 {
   return (table == NULL) ?  0 : table->size;
 }
 
+/* hash_table_empty -- détermine si la table est vide.
+ * Complexité: O(1)
+ */
 int hash_table_empty(HashTable *table)
 {
   return (hash_table_size(table) == 0);
 }
 
+/* hash_table_full -- détermine si la table est pleine. Comme elle
+ * s'agrandit automatiquement, ce n'est jamais le cas.
+ * Complexité: O(1)
+ */
 int hash_table_full(HashTable *table)
 {
-  return (hash_table_size(table) == hash_table_max_size(table));
+  (void) table;
+  return 0;
+}
+
+/* hash_table_count_buckets (fonction interne) -- ajoute à histogram les
+ * longueurs des n paniers de items, et renvoie la plus grande.
+ * Complexité: O(n + nombre d'entrées)
+ */
+static int hash_table_count_buckets(HashItem **items, int n, int *histogram, int nbins)
+{
+  HashItem *hi;
+  int i, len, max = 0;
+
+  for (i = 0; i < n; i++) {
+    for (len = 0, hi = items[i]; hi != NULL; hi = hi->next)
+      len++;
+    histogram[(len < nbins - 1) ? len : nbins - 1] += 1;
+    if (len > max) max = len;
+  }
+  return max;
+}
+
+/* hash_table_stats -- mesure la qualité de la fonction de hachage:
+ * range dans histogram[i] le nombre de paniers contenant i clés, pour i
+ * de 0 à nbins-2; histogram[nbins-1] compte les paniers d'au moins
+ * nbins-1 clés. Avec une bonne fonction, les longueurs suivent une loi de
+ * Poisson de paramètre hash_table_size(table)/hash_table_max_size(table).
+ * Renvoie la longueur de la plus longue liste de collision.
+ * Complexité: O(hash_table_max_size(table) + hash_table_size(table))
+ */
+int hash_table_stats(HashTable *table, int *histogram, int nbins)
+{
+  int i, max, old;
+
+  assert((table != NULL) && (histogram != NULL) && (nbins > 0));
+  for (i = 0; i < nbins; i++)
+    histogram[i] = 0;
+  max = hash_table_count_buckets(table->items, table->max_size, histogram, nbins);
+  /* Pendant un agrandissement, les anciens paniers pas encore migrés
+   * comptent aussi.
+   */
+  if (table->old_items != NULL) {
+    old = hash_table_count_buckets(table->old_items + table->migrated,
+                                   table->old_max_size - table->migrated,
+                                   histogram, nbins);
+    if (old > max) max = old;
+  }
+  return max;
 }
@@ -1,28 +1,119 @@
 #ifndef HASH_H
 #define HASH_H
-#include "slist.h"
+#include "pool.h"
+#include "hashfn.h"
 
-typedef struct {
+/* Nombre de paniers de l'ancienne table migrés à chaque opération
+ * pendant un agrandissement.
+ */
+#define HASH_MIGRATE_STEP 4
+
+/* Nombre d'entrées par slab de la réserve d'une table */
+#define HASH_SLAB_ITEMS 256
+
+/* Une entrée de la table. Les entrées d'un meme panier sont chainées
+ * directement entre elles, et proviennent de la réserve (Pool) de la
+ * table: une insertion ne fait en général aucun appel à malloc.
+ */
+typedef struct _hash_item {
   void *key;
   void *item;
+  struct _hash_item *next;      /* Entrée suivante du meme panier */
 } HashItem;
 
+/* Le nombre de paniers est une puissance de 2. Le code renvoyé par h est
+ * d'abord mélangé par hash_mix32, puis ses bits de poids faible donnent le
+ * panier: une fonction h médiocre (l'identité sur des entiers, par
+ * exemple) ne crée pas de paquets, et un code négatif ne pose pas de
+ * problème.
+ *
+ * Quand la table devient trop chargée, un tableau de paniers deux fois
+ * plus grand est alloué, mais les éléments ne sont pas tous déplacés d'un
+ * coup: l'ancien et le nouveau tableau coexistent, et chaque opération
+ * migre au plus HASH_MIGRATE_STEP anciens paniers. Le cout d'un
+ * agrandissement est ainsi réparti sur les opérations suivantes.
+ */
 typedef struct {
-  int max_size;
-  int size;
+  int max_size;                 /* Nombre de paniers (puissance de 2) */
+  int size;                     /* Nombre de clés */
   int (*h)(void *);             /* Convertie une clé en entier */
   int (*kequal)(void *, void*);  /* Prédicat de comparaison de clés */
-  SList **items;
+  HashItem **items;             /* Paniers */
+  int old_max_size;             /* Nombre d'anciens paniers (0 si aucun) */
+  int migrated;                 /* Nombre d'anciens paniers déjà migrés */
+  HashItem **old_items;         /* Anciens paniers, en cours de migration */
+  Pool *pool;                   /* Réserve des entrées */
 } HashTable;
 
+/* hash_table_new -- crée une table de hachage d'au moins max_size
+ * paniers (arrondi à la puissance de 2 supérieure). La table
+ * s'agrandit automatiquement quand elle contient plus de clés que de
+ * paniers.
+ * Retourne un pointeur sur cette table, ou NULL en cas d'échec.
+ * Complexité: O(max_size)
+ */
 extern HashTable *hash_table_new(int max_size, int (*h)(void *), int (*kequal)(void *, void *));
+
+/* hash_table_free -- détruit une table et libère la mémoire qu'elle
+ * occupait (mais pas celle des clés et des données).
+ * Complexité: O(nombre de slabs)
+ */
 extern void hash_table_free(HashTable *table);
+
+/* hash_table_clear -- retire toutes les clés de la table, qui garde sa
+ * taille et sa mémoire pour etre réutilisée.
+ * Complexité: O(hash_table_max_size(table))
+ */
+extern void hash_table_clear(HashTable *table);
+
+/* hash_table_insert -- associe item à key.
+ * La valeur de retour indique si l'insertion s'est faite (0 si key est
+ * déjà présente ou en cas d'erreur d'allocation mémoire).
+ * Complexité: O(1) en moyenne, y compris pendant un agrandissement
+ */
 extern int hash_table_insert(HashTable *table, void *key, void *item);
-extern int hash_table_remove(HashTable *table, void *item);
+
+/* hash_table_remove -- retire key de la table.
+ * La valeur de retour indique si key était présente.
+ * Complexité: O(1) en moyenne
+ */
+extern int hash_table_remove(HashTable *table, void *key);
+
+/* hash_table_find -- renvoie la donnée associée à key, ou NULL si key
+ * n'est pas dans la table.
+ * Complexité: O(1) en moyenne
+ */
 extern void *hash_table_find(HashTable *table, void *key);
+
+/* hash_table_max_size -- renvoie le nombre de paniers de la table.
+ * Complexité: O(1)
+ */
 extern int hash_table_max_size(HashTable *table);
+
+/* hash_table_size -- renvoie le nombre de clés de la table.
+ * Complexité: O(1)
+ */
 extern int hash_table_size(HashTable *table);
+
+/* hash_table_empty -- détermine si la table est vide.
+ * Complexité: O(1)
+ */
 extern int hash_table_empty(HashTable *table);
+
+/* hash_table_full -- détermine si la table est pleine. Comme elle
+ * s'agrandit automatiquement, ce n'est jamais le cas.
+ * Complexité: O(1)
+ */
 extern int hash_table_full(HashTable *table);
 
+/* hash_table_stats -- mesure la qualité de la fonction de hachage:
+ * range dans histogram[i] le nombre de paniers contenant i clés, pour i
+ * de 0 à nbins-2; histogram[nbins-1] compte les paniers d'au moins
+ * nbins-1 clés. Avec une bonne fonction, les longueurs suivent une loi de
+ * Poisson de paramètre hash_table_size(table)/hash_table_max_size(table).
+ * Renvoie la longueur de la plus longue liste de collision.
+ * Complexité: O(hash_table_max_size(table) + hash_table_size(table))
+ */
+extern int hash_table_stats(HashTable *table, int *histogram, int nbins);
+
 #endif /* HASH_H */
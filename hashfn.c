@@ -0,0 +1,224 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "hashfn.h"
+
+/* Constantes de wyhash: des entiers impairs de 64 bits ayant autant de
+ * bits à 1 que de bits à 0.
+ */
+#define HASH_P0 0xa0761d6478bd642fULL
+#define HASH_P1 0xe7037ed1a0b428dbULL
+#define HASH_P2 0x8ebc6af09c88c6e3ULL
+#define HASH_P3 0x589965cc75374cc3ULL
+
+/* hash_mix32 -- mélange les bits d'un entier de 32 bits (finaliseur de
+ * MurmurHash3). C'est une bijection.
+ * Complexité: O(1)
+ */
+uint32_t hash_mix32(uint32_t x)
+{
+  x ^= x >> 16;
+  x *= 0x85EBCA6BU;
+  x ^= x >> 13;
+  x *= 0xC2B2AE35U;
+  x ^= x >> 16;
+  return x;
+}
+
+/* hash_mix64 -- mélange les bits d'un entier de 64 bits (finaliseur de
+ * MurmurHash3). C'est une bijection.
+ * Complexité: O(1)
+ */
+uint64_t hash_mix64(uint64_t x)
+{
+  x ^= x >> 33;
+  x *= 0xFF51AFD7ED558CCDULL;
+  x ^= x >> 33;
+  x *= 0xC4CEB9FE1A85EC53ULL;
+  x ^= x >> 33;
+  return x;
+}
+
+/* hash_mul128 (fonction interne) -- multiplie *a par *b sur 128 bits, et
+ * range les 64 bits de poids faible du produit dans *a et ceux de poids
+ * fort dans *b.
+ * Complexité: O(1)
+ */
+static void hash_mul128(uint64_t *a, uint64_t *b)
+{
+#ifdef __SIZEOF_INT128__
+  unsigned __int128 r = (unsigned __int128) *a * *b;
+
+  *a = (uint64_t) r;
+  *b = (uint64_t) (r >> 64);
+#else
+  uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t) *a, lb = (uint32_t) *b;
+  uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  uint64_t t = rl + (rm0 << 32), lo;
+  uint64_t c = t < rl;
+
+  lo = t + (rm1 << 32);
+  c += lo < t;
+  *a = lo;
+  *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+/* hash_mum (fonction interne) -- multiplie a par b sur 128 bits et
+ * renvoie le ou exclusif des deux moitiés du produit.
+ * Complexité: O(1)
+ */
+static uint64_t hash_mum(uint64_t a, uint64_t b)
+{
+  hash_mul128(&a, &b);
+  return a ^ b;
+}
+
+/* hash_read64, hash_read32 (fonctions internes) -- lisent un entier à une
+ * adresse quelconque (pas forcément alignée).
+ * Complexité: O(1)
+ */
+static uint64_t hash_read64(const unsigned char *p)
+{
+  uint64_t v;
+
+  memcpy(&v, p, 8);
+  return v;
+}
+
+static uint64_t hash_read32(const unsigned char *p)
+{
+  uint32_t v;
+
+  memcpy(&v, p, 4);
+  return v;
+}
+
+/* hash_bytes -- renvoie le code de hachage des len octets pointés par
+ * data. seed permet d'obtenir des familles de fonctions indépendantes.
+ * Complexité: O(len)
+ */
+uint64_t hash_bytes(const void *data, size_t len, uint64_t seed)
+{
+  const unsigned char *p = (const unsigned char *) data;
+  uint64_t a, b, see1, see2;
+  size_t i = len;
+
+  assert((data != NULL) || (len == 0));
+  seed ^= hash_mum(seed ^ HASH_P0, HASH_P1);
+  if (len <= 16) {
+    if (len >= 4) {
+      /* Deux lectures de 4 octets à chaque bout, qui se recouvrent */
+      a = (hash_read32(p) << 32) | hash_read32(p + ((len >> 3) << 2));
+      b = (hash_read32(p + len - 4) << 32) |
+        hash_read32(p + len - 4 - ((len >> 3) << 2));
+    } else if (len > 0) {
+      a = ((uint64_t) p[0] << 16) | ((uint64_t) p[len >> 1] << 8) | p[len - 1];
+      b = 0;
+    } else
+      a = b = 0;
+  } else {
+    if (i > 48) {
+      /* Trois chaines indépendantes, pour occuper le processeur */
+      see1 = see2 = seed;
+      do {
+        seed = hash_mum(hash_read64(p) ^ HASH_P1, hash_read64(p + 8) ^ seed);
+        see1 = hash_mum(hash_read64(p + 16) ^ HASH_P2, hash_read64(p + 24) ^ see1);
+        see2 = hash_mum(hash_read64(p + 32) ^ HASH_P3, hash_read64(p + 40) ^ see2);
+        p += 48;
+        i -= 48;
+      } while (i > 48);
+      seed ^= see1 ^ see2;
+    }
+    while (i > 16) {
+      seed = hash_mum(hash_read64(p) ^ HASH_P1, hash_read64(p + 8) ^ seed);
+      p += 16;
+      i -= 16;
+    }
+    /* Les 16 derniers octets, quitte à en relire certains */
+    a = hash_read64(p + i - 16);
+    b = hash_read64(p + i - 8);
+  }
+  a ^= HASH_P1;
+  b ^= seed;
+  hash_mul128(&a, &b);
+  return hash_mum(a ^ HASH_P0 ^ (uint64_t) len, b ^ HASH_P1);
+}
+
+/* hash_string -- renvoie le code de hachage de la chaine s (sans le 0
+ * final).
+ * Complexité: O(longueur(s))
+ */
+uint64_t hash_string(const char *s, uint64_t seed)
+{
+  assert(s != NULL);
+  return hash_bytes(s, strlen(s), seed);
+}
+
+/* hash_int_key -- code de hachage d'une clé pointant sur un int.
+ * Complexité: O(1)
+ */
+int hash_int_key(void *key)
+{
+  return (int) hash_mix32((uint32_t) *(int *) key);
+}
+
+/* hash_int_equal -- détermine si deux clés pointent sur des int égaux.
+ * Complexité: O(1)
+ */
+int hash_int_equal(void *a, void *b)
+{
+  return *(int *) a == *(int *) b;
+}
+
+/* hash_u64_key -- code de hachage d'une clé pointant sur un uint64_t.
+ * Complexité: O(1)
+ */
+int hash_u64_key(void *key)
+{
+  return (int) hash_mix64(*(uint64_t *) key);
+}
+
+/* hash_u64_equal -- détermine si deux clés pointent sur des uint64_t
+ * égaux.
+ * Complexité: O(1)
+ */
+int hash_u64_equal(void *a, void *b)
+{
+  return *(uint64_t *) a == *(uint64_t *) b;
+}
+
+/* hash_ptr_key -- code de hachage d'une clé comparée par adresse (c'est
+ * la valeur du pointeur lui-meme qui est hachée).
+ * Complexité: O(1)
+ */
+int hash_ptr_key(void *key)
+{
+  return (int) hash_mix64((uint64_t) (uintptr_t) key);
+}
+
+/* hash_ptr_equal -- détermine si deux clés sont le meme pointeur.
+ * Complexité: O(1)
+ */
+int hash_ptr_equal(void *a, void *b)
+{
+  return a == b;
+}
+
+/* hash_string_key -- code de hachage d'une clé chaine de caractères.
+ * Complexité: O(longueur(key))
+ */
+int hash_string_key(void *key)
+{
+  return (int) hash_string((const char *) key, 0);
+}
+
+/* hash_string_equal -- détermine si deux clés sont des chaines égales.
+ * Complexité: O(longueur(a))
+ */
+int hash_string_equal(void *a, void *b)
+{
+  return strcmp((const char *) a, (const char *) b) == 0;
+}
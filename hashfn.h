@@ -0,0 +1,86 @@
+#ifndef HASHFN_H
+#define HASHFN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Fonctions de hachage.
+ * hash_mix32 et hash_mix64 mélangent les bits d'un entier: chaque bit du
+ * résultat dépend de tous les bits de l'entrée. Les tables de la
+ * bibliothèque s'en servent pour corriger les fonctions h médiocres
+ * (identité, adresses alignées...) avant de choisir un panier.
+ * hash_bytes hache une suite d'octets quelconque; c'est une variante de
+ * wyhash (Wang Yi), qui traite 8 à 48 octets par tour de boucle à l'aide
+ * de multiplications 64x64->128 bits.
+ * hash_int_key, hash_u64_key, hash_ptr_key et hash_string_key (et les
+ * prédicats d'égalité correspondants) ont directement la signature
+ * attendue par hash_table_new et ohash_table_new.
+ */
+
+/* hash_mix32 -- mélange les bits d'un entier de 32 bits (finaliseur de
+ * MurmurHash3). C'est une bijection.
+ * Complexité: O(1)
+ */
+extern uint32_t hash_mix32(uint32_t x);
+
+/* hash_mix64 -- mélange les bits d'un entier de 64 bits (finaliseur de
+ * MurmurHash3). C'est une bijection.
+ * Complexité: O(1)
+ */
+extern uint64_t hash_mix64(uint64_t x);
+
+/* hash_bytes -- renvoie le code de hachage des len octets pointés par
+ * data. seed permet d'obtenir des familles de fonctions indépendantes.
+ * Complexité: O(len)
+ */
+extern uint64_t hash_bytes(const void *data, size_t len, uint64_t seed);
+
+/* hash_string -- renvoie le code de hachage de la chaine s (sans le 0
+ * final).
+ * Complexité: O(longueur(s))
+ */
+extern uint64_t hash_string(const char *s, uint64_t seed);
+
+/* hash_int_key -- code de hachage d'une clé pointant sur un int.
+ * Complexité: O(1)
+ */
+extern int hash_int_key(void *key);
+
+/* hash_int_equal -- détermine si deux clés pointent sur des int égaux.
+ * Complexité: O(1)
+ */
+extern int hash_int_equal(void *a, void *b);
+
+/* hash_u64_key -- code de hachage d'une clé pointant sur un uint64_t.
+ * Complexité: O(1)
+ */
+extern int hash_u64_key(void *key);
+
+/* hash_u64_equal -- détermine si deux clés pointent sur des uint64_t
+ * égaux.
+ * Complexité: O(1)
+ */
+extern int hash_u64_equal(void *a, void *b);
+
+/* hash_ptr_key -- code de hachage d'une clé comparée par adresse (c'est
+ * la valeur du pointeur lui-meme qui est hachée).
+ * Complexité: O(1)
+ */
+extern int hash_ptr_key(void *key);
+
+/* hash_ptr_equal -- détermine si deux clés sont le meme pointeur.
+ * Complexité: O(1)
+ */
+extern int hash_ptr_equal(void *a, void *b);
+
+/* hash_string_key -- code de hachage d'une clé chaine de caractères.
+ * Complexité: O(longueur(key))
+ */
+extern int hash_string_key(void *key);
+
+/* hash_string_equal -- détermine si deux clés sont des chaines égales.
+ * Complexité: O(longueur(a))
+ */
+extern int hash_string_equal(void *a, void *b);
+
+#endif /* HASHFN_H */
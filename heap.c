@@ -4,8 +4,40 @@
 
 #include "heap.h"
 
-/* heap_create -- crée un tas d'une taille maximale donnée, ordonné par
- * la relation rel.
+/* heap_init -- initialise le tas h (alloué par l'appelant, par exemple
+ * à l'intérieur d'une autre structure), vide, d'une taille initiale
+ * donnée et ordonné par la relation rel.
+ * La valeur de retour indique si l'initialisation s'est bien passée.
+ * Complexité: O(1)
+ */
+int heap_init(Heap *h, int max_size, relation rel)
+{
+  assert((h != NULL) && (max_size > 0) && (rel != NULL));
+  if ((h->tab = (void **) malloc(max_size*sizeof(void *))) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "heap_init: erreur d'allocation mémoire.\n");
+#endif
+    return 0;
+  }
+  h->size = 0;
+  h->max = max_size;
+  h->rel = rel;
+  return 1;
+}
+
+/* heap_destroy -- libère la mémoire occupée par les données d'un tas
+ * initialisé par heap_init, mais pas le tas lui-meme.
+ * Complexité: O(1)
+ */
+void heap_destroy(Heap *h)
+{
+  assert(h != NULL);
+  if (h->tab != NULL) free(h->tab);
+  h->tab = NULL;
+}
+
+/* heap_create -- crée un tas d'une taille initiale donnée, ordonné par
+ * la relation rel. Le tas s'agrandit automatiquement si nécessaire.
  * Retourne un pointeur sur ce nouveau tas, ou NULL si la création
  * ne s'est pas bien passée.
  * Complexité: O(1)
@@ -21,16 +53,10 @@ Heap *heap_create(int max_size, relation rel)
 #endif
     return NULL;
   }
-  if ((tmp->tab = (void **) malloc(max_size*sizeof(void *))) == NULL) {
-#ifdef DEBUG
-    fprintf(stderr, "heap_create: erreur d'allocation mémoire.\n");
-#endif
+  if (!heap_init(tmp, max_size, rel)) {
     free (tmp);
     return NULL;
   }
-  tmp->size = 0;
-  tmp->max = max_size;
-  tmp->rel = rel;
   return tmp;
 }
 
@@ -41,7 +67,7 @@ Heap *heap_create(int max_size, relation rel)
 void heap_free(Heap *h)
 {
   assert(h != NULL);
-  if (h->tab != NULL) free (h->tab);
+  heap_destroy(h);
   free (h);
 }
 
@@ -55,8 +81,8 @@ int heap_size(Heap *h)
   return h->size;
 }
 
-/* heap_max_size -- renvoie le nombre maximum d'éléments qu'un tas peut
- * contenir.
+/* heap_max_size -- renvoie le nombre d'éléments qu'un tas peut
+ * contenir sans avoir à s'agrandir.
  * Complexité: O(1)
  */
 int heap_max_size(Heap *h)
@@ -133,6 +159,61 @@ static void heap_shift_up(Heap *h, int i)
   }
 }
 
+/* heap_build -- crée un tas ordonné par la relation rel à partir des size
+ * premiers éléments du tableau tab, de taille max_size.
+ * Le tableau n'est pas recopié: le tas en devient propriétaire et le
+ * réorganise sur place. Il doit donc avoir été alloué par malloc, et sera
+ * libéré par heap_free (ou agrandi par realloc si nécessaire).
+ * En cas d'échec, renvoie NULL et le tableau reste à l'appelant.
+ * Complexité: O(size)
+ */
+Heap *heap_build(void **tab, int size, int max_size, relation rel)
+{
+  Heap *tmp;
+  int i;
+
+  assert((tab != NULL) && (size >= 0) && (max_size > 0) &&
+         (size <= max_size) && (rel != NULL));
+  if ((tmp = (Heap *) malloc(sizeof(Heap))) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "heap_build: erreur d'allocation mémoire.\n");
+#endif
+    return NULL;
+  }
+  tmp->tab = tab;
+  tmp->size = size;
+  tmp->max = max_size;
+  tmp->rel = rel;
+  /* Construction par le bas: on fait descendre chaque père, du dernier
+   * jusqu'à la racine. Les feuilles sont déjà des tas.
+   */
+  if (size > 1)
+    for (i = heap_father(size-1); i >= 0; i--)
+      heap_shift_down(tmp, i);
+  return tmp;
+}
+
+/* heap_grow (fonction interne) -- double la taille du tableau qui contient
+ * les données du tas.
+ * La valeur de retour indique si l'agrandissement s'est bien passé.
+ * Complexité: O(heap_size(h))
+ */
+static int heap_grow(Heap *h)
+{
+  void **tab;
+
+  assert((h != NULL) && (h->tab != NULL));
+  if ((tab = (void **) realloc(h->tab, 2*h->max*sizeof(void *))) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "heap_grow: erreur d'allocation mémoire.\n");
+#endif
+    return 0;
+  }
+  h->tab = tab;
+  h->max *= 2;
+  return 1;
+}
+
 /* heap_extract_root -- retire le sommet du tas et renvoie sa valeur
  * (en fait un pointeur sur son contenu).
  * Complexité: O(ln(heap_size(h)))
@@ -150,14 +231,16 @@ void *heap_extract_root(Heap *h)
   return tmp;
 }
 
-/* heap_insert -- insère un nouvel élément dans le tas.
- * La valeur de retour indique si l'insertion s'est bien passée.
- * Complexité: O(ln(heap_size(h)))
+/* heap_insert -- insère un nouvel élément dans le tas. Si le tas est
+ * plein, sa taille est doublée.
+ * La valeur de retour indique si l'insertion s'est bien passée (0 en cas
+ * d'erreur d'allocation mémoire).
+ * Complexité: O(ln(heap_size(h))) amortie
  */
 int heap_insert(Heap *h, void *item)
 {
   assert((h != NULL) && (h->tab != NULL) && (item != NULL));
-  if (heap_size(h) == heap_max_size(h))
+  if ((heap_size(h) == heap_max_size(h)) && !heap_grow(h))
     return 0;
   h->tab[h->size++] = item;
   heap_shift_up(h, h->size-1);
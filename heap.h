@@ -15,14 +15,38 @@ typedef struct {
 } Heap;
 
 
-/* heap_create -- crée un tas d'une taille maximale donnée, ordonné par
- * la relation rel.
+/* heap_init -- initialise le tas h (alloué par l'appelant, par exemple
+ * à l'intérieur d'une autre structure), vide, d'une taille initiale
+ * donnée et ordonné par la relation rel.
+ * La valeur de retour indique si l'initialisation s'est bien passée.
+ * Complexité: O(1)
+ */
+extern int heap_init(Heap *h, int max_size, relation rel);
+
+/* heap_destroy -- libère la mémoire occupée par les données d'un tas
+ * initialisé par heap_init, mais pas le tas lui-meme.
+ * Complexité: O(1)
+ */
+extern void heap_destroy(Heap *h);
+
+/* heap_create -- crée un tas d'une taille initiale donnée, ordonné par
+ * la relation rel. Le tas s'agrandit automatiquement si nécessaire.
  * Retourne un pointeur sur ce nouveau tas, ou NULL si la création
  * ne s'est pas bien passée.
  * Complexité: O(1)
  */
 extern Heap *heap_create(int max_size, relation rel);
 
+/* heap_build -- crée un tas ordonné par la relation rel à partir des size
+ * premiers éléments du tableau tab, de taille max_size.
+ * Le tableau n'est pas recopié: le tas en devient propriétaire et le
+ * réorganise sur place. Il doit donc avoir été alloué par malloc, et sera
+ * libéré par heap_free (ou agrandi par realloc si nécessaire).
+ * En cas d'échec, renvoie NULL et le tableau reste à l'appelant.
+ * Complexité: O(size)
+ */
+extern Heap *heap_build(void **tab, int size, int max_size, relation rel);
+
 /* heap_free -- détruit un tas et libére la mémoire qu'il occupait.
  * Complexité: O(1);
  */
@@ -40,8 +64,8 @@ extern void *heap_root(Heap *h);
  */
 extern int heap_size(Heap *h);
 
-/* heap_max_size -- renvoie le nombre maximum d'éléments qu'un tas peut
- * contenir.
+/* heap_max_size -- renvoie le nombre d'éléments qu'un tas peut
+ * contenir sans avoir à s'agrandir.
  * Complexité: O(1)
  */
 extern int heap_max_size(Heap *h);
@@ -52,9 +76,11 @@ extern int heap_max_size(Heap *h);
  */
 extern void *heap_extract_root(Heap *h);
 
-/* heap_insert -- insère un nouvel élément dans le tas.
- * La valeur de retour indique si l'insertion s'est bien passée.
- * Complexité: O(ln(heap_size(h)))
+/* heap_insert -- insère un nouvel élément dans le tas. Si le tas est
+ * plein, sa taille est doublée.
+ * La valeur de retour indique si l'insertion s'est bien passée (0 en cas
+ * d'erreur d'allocation mémoire).
+ * Complexité: O(ln(heap_size(h))) amortie
  */
 extern int heap_insert(Heap *h, void *item);
 
@@ -0,0 +1,297 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "iheap.h"
+
+/* iheap_create -- crée un tas indexé pouvant contenir les identifiants
+ * 0 à max_size-1, ordonné par la relation rel.
+ * Retourne un pointeur sur ce nouveau tas, ou NULL si la création
+ * ne s'est pas bien passée.
+ * Complexité: O(max_size)
+ */
+IHeap *iheap_create(int max_size, relation rel)
+{
+  IHeap *tmp;
+  int i;
+
+  assert((max_size > 0) && (rel != NULL));
+  if ((tmp = (IHeap *) malloc(sizeof(IHeap))) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "iheap_create: erreur d'allocation mémoire.\n");
+#endif
+    return NULL;
+  }
+  tmp->heap = (int *) malloc(max_size*sizeof(int));
+  tmp->pos = (int *) malloc(max_size*sizeof(int));
+  tmp->items = (void **) malloc(max_size*sizeof(void *));
+  if ((tmp->heap == NULL) || (tmp->pos == NULL) || (tmp->items == NULL)) {
+#ifdef DEBUG
+    fprintf(stderr, "iheap_create: erreur d'allocation mémoire.\n");
+#endif
+    iheap_free(tmp);
+    return NULL;
+  }
+  for (i = 0; i < max_size; i++) {
+    tmp->pos[i] = -1;
+    tmp->items[i] = NULL;
+  }
+  tmp->size = 0;
+  tmp->max = max_size;
+  tmp->rel = rel;
+  return tmp;
+}
+
+/* iheap_free -- détruit un tas indexé et libère la mémoire qu'il occupait.
+ * Complexité: O(1)
+ */
+void iheap_free(IHeap *h)
+{
+  assert(h != NULL);
+  if (h->heap != NULL) free(h->heap);
+  if (h->pos != NULL) free(h->pos);
+  if (h->items != NULL) free(h->items);
+  free(h);
+}
+
+/* iheap_size -- renvoie le nombre d'éléments contenus dans le tas.
+ * Complexité: O(1)
+ */
+int iheap_size(IHeap *h)
+{
+  assert(h != NULL);
+  return h->size;
+}
+
+/* iheap_max_size -- renvoie le nombre d'identifiants que le tas peut
+ * contenir.
+ * Complexité: O(1)
+ */
+int iheap_max_size(IHeap *h)
+{
+  assert(h != NULL);
+  return h->max;
+}
+
+/* iheap_contains -- détermine si l'identifiant id est présent dans le tas.
+ * Complexité: O(1)
+ */
+int iheap_contains(IHeap *h, int id)
+{
+  assert((h != NULL) && (h->pos != NULL));
+  return (id >= 0) && (id < h->max) && (h->pos[id] != -1);
+}
+
+/* iheap_get -- renvoie la donnée associée à id, ou NULL si id n'est
+ * pas dans le tas.
+ * Complexité: O(1)
+ */
+void *iheap_get(IHeap *h, int id)
+{
+  return iheap_contains(h, id) ? h->items[id] : NULL;
+}
+
+/* iheap_root -- renvoie la donnée placée à la racine du tas (ie son
+ * plus "petit" élément). Ne modifie PAS le tas.
+ * Complexité: O(1)
+ */
+void *iheap_root(IHeap *h)
+{
+  assert((h != NULL) && (h->heap != NULL) && (h->size != 0));
+  return h->items[h->heap[0]];
+}
+
+/* iheap_root_id -- renvoie l'identifiant de la racine du tas, ou -1 si
+ * le tas est vide.
+ * Complexité: O(1)
+ */
+int iheap_root_id(IHeap *h)
+{
+  assert((h != NULL) && (h->heap != NULL));
+  return (h->size == 0) ? -1 : h->heap[0];
+}
+
+/* iheap_shift_up (fonction interne) -- fait remonter à sa place l'élément
+ * situé en position i.
+ * Plutot que de faire des échanges, on décale les pères vers le bas et on
+ * ne place l'élément qu'une seule fois, à la fin.
+ * Complexité: O(ln(iheap_size(h)))
+ */
+static void iheap_shift_up(IHeap *h, int i)
+{
+  int id = h->heap[i];
+  int f;
+
+  while (i > 0) {
+    f = heap_father(i);
+    if (!h->rel(h->items[h->heap[f]], h->items[id])) /* father <= item */
+      break;
+    h->heap[i] = h->heap[f];
+    h->pos[h->heap[i]] = i;
+    i = f;
+  }
+  h->heap[i] = id;
+  h->pos[id] = i;
+}
+
+/* iheap_shift_down (fonction interne) -- fait descendre à sa place
+ * l'élément situé en position i.
+ * Complexité: O(ln(iheap_size(h)))
+ */
+static void iheap_shift_down(IHeap *h, int i)
+{
+  int id = h->heap[i];
+  int max_i = h->size - 1;      /* Indice à ne pas dépasser */
+  int next_i;
+
+  while (heap_left_son(i) <= max_i) {
+    /* Détermine le plus petit des fils */
+    next_i = heap_left_son(i);
+    if ((heap_right_son(i) <= max_i) &&
+        (h->rel(h->items[h->heap[next_i]], h->items[h->heap[heap_right_son(i)]])))
+      next_i = heap_right_son(i);
+    if (!h->rel(h->items[id], h->items[h->heap[next_i]]))
+      break;
+    h->heap[i] = h->heap[next_i];
+    h->pos[h->heap[i]] = i;
+    i = next_i;
+  }
+  h->heap[i] = id;
+  h->pos[id] = i;
+}
+
+/* iheap_delete_at (fonction interne) -- retire l'élément situé en
+ * position i et comble le trou avec le dernier élément du tas.
+ * Complexité: O(ln(iheap_size(h)))
+ */
+static void iheap_delete_at(IHeap *h, int i)
+{
+  int id = h->heap[i];
+
+  h->size -= 1;
+  if (i != h->size) {
+    h->heap[i] = h->heap[h->size];
+    h->pos[h->heap[i]] = i;
+    /* Le dernier élément peut etre plus petit ou plus grand que celui
+     * qu'il remplace.
+     */
+    if ((i > 0) && h->rel(h->items[h->heap[heap_father(i)]], h->items[h->heap[i]]))
+      iheap_shift_up(h, i);
+    else
+      iheap_shift_down(h, i);
+  }
+  h->pos[id] = -1;
+  h->items[id] = NULL;
+}
+
+/* iheap_extract_root -- retire la racine du tas et renvoie son
+ * identifiant (-1 si le tas est vide). Si item n'est pas NULL, la donnée
+ * associée y est recopiée.
+ * Complexité: O(ln(iheap_size(h)))
+ */
+int iheap_extract_root(IHeap *h, void **item)
+{
+  int id;
+
+  assert((h != NULL) && (h->heap != NULL));
+  if (h->size == 0) return -1;
+  id = h->heap[0];
+  if (item != NULL) *item = h->items[id];
+  iheap_delete_at(h, 0);
+  return id;
+}
+
+/* iheap_insert -- insère l'élément id, de donnée item, dans le tas.
+ * La valeur de retour indique si l'insertion s'est bien passée (0 si
+ * id est invalide ou déjà présent).
+ * Complexité: O(ln(iheap_size(h)))
+ */
+int iheap_insert(IHeap *h, int id, void *item)
+{
+  assert((h != NULL) && (h->heap != NULL) && (item != NULL));
+  if ((id < 0) || (id >= h->max) || (h->pos[id] != -1))
+    return 0;
+  h->items[id] = item;
+  h->heap[h->size] = id;
+  h->size += 1;
+  iheap_shift_up(h, h->size-1);
+  return 1;
+}
+
+/* iheap_decrease_key -- remplace la donnée associée à id par item, qui
+ * ne doit pas etre plus "grande" que l'ancienne.
+ * La valeur de retour indique si id était présent.
+ * Complexité: O(ln(iheap_size(h)))
+ */
+int iheap_decrease_key(IHeap *h, int id, void *item)
+{
+  assert((h != NULL) && (item != NULL));
+  if (!iheap_contains(h, id)) return 0;
+  h->items[id] = item;
+  iheap_shift_up(h, h->pos[id]);
+  return 1;
+}
+
+/* iheap_increase_key -- remplace la donnée associée à id par item, qui
+ * ne doit pas etre plus "petite" que l'ancienne.
+ * La valeur de retour indique si id était présent.
+ * Complexité: O(ln(iheap_size(h)))
+ */
+int iheap_increase_key(IHeap *h, int id, void *item)
+{
+  assert((h != NULL) && (item != NULL));
+  if (!iheap_contains(h, id)) return 0;
+  h->items[id] = item;
+  iheap_shift_down(h, h->pos[id]);
+  return 1;
+}
+
+/* iheap_update -- remplace la donnée associée à id par item, quel que
+ * soit le sens de la modification.
+ * La valeur de retour indique si id était présent.
+ * Complexité: O(ln(iheap_size(h)))
+ */
+int iheap_update(IHeap *h, int id, void *item)
+{
+  int i;
+
+  assert((h != NULL) && (item != NULL));
+  if (!iheap_contains(h, id)) return 0;
+  h->items[id] = item;
+  i = h->pos[id];
+  if ((i > 0) && h->rel(h->items[h->heap[heap_father(i)]], item))
+    iheap_shift_up(h, i);
+  else
+    iheap_shift_down(h, i);
+  return 1;
+}
+
+/* iheap_remove -- retire l'élément id du tas.
+ * La valeur de retour indique si id était présent.
+ * Complexité: O(ln(iheap_size(h)))
+ */
+int iheap_remove(IHeap *h, int id)
+{
+  assert(h != NULL);
+  if (!iheap_contains(h, id)) return 0;
+  iheap_delete_at(h, h->pos[id]);
+  return 1;
+}
+
+/* iheap_print -- affiche le tas à l'écran. Affiche chacun des
+ * éléments avec la fonction print_data.
+ * Complexité: O(iheap_size(h))
+ */
+void iheap_print(IHeap *h, void (*print_data)(void *))
+{
+  int i;
+
+  assert((h != NULL) && (h->heap != NULL) && (print_data != NULL));
+  printf("(");
+  for (i = 0; i < h->size; i++) {
+    if (i > 0) printf(", ");
+    printf("%d:", h->heap[i]);
+    print_data(h->items[h->heap[i]]);
+  }
+  printf(")");
+}
@@ -0,0 +1,114 @@
+#ifndef IHEAP_H
+#define IHEAP_H
+
+#include "heap.h"
+
+/* Tas indexé: chaque élément est identifié par un entier id compris
+ * entre 0 et max-1. La position de chaque identifiant dans le tas est
+ * conservée, ce qui permet de modifier la priorité d'un élément (ou de
+ * le retirer) sans avoir à insérer de doublons.
+ */
+typedef struct {
+  int size;                     /* Taille effective du tas */
+  int max;                      /* Nombre d'identifiants possibles */
+  relation rel;                 /* Relation d'ordre utilisée pour ordonner le tas */
+  int *heap;                    /* heap[i] = identifiant placé en position i */
+  int *pos;                     /* pos[id] = position de id, ou -1 s'il est absent */
+  void **items;                 /* items[id] = donnée associée à id */
+} IHeap;
+
+/* iheap_create -- crée un tas indexé pouvant contenir les identifiants
+ * 0 à max_size-1, ordonné par la relation rel.
+ * Retourne un pointeur sur ce nouveau tas, ou NULL si la création
+ * ne s'est pas bien passée.
+ * Complexité: O(max_size)
+ */
+extern IHeap *iheap_create(int max_size, relation rel);
+
+/* iheap_free -- détruit un tas indexé et libère la mémoire qu'il occupait.
+ * Complexité: O(1)
+ */
+extern void iheap_free(IHeap *h);
+
+/* iheap_size -- renvoie le nombre d'éléments contenus dans le tas.
+ * Complexité: O(1)
+ */
+extern int iheap_size(IHeap *h);
+
+/* iheap_max_size -- renvoie le nombre d'identifiants que le tas peut
+ * contenir.
+ * Complexité: O(1)
+ */
+extern int iheap_max_size(IHeap *h);
+
+/* iheap_contains -- détermine si l'identifiant id est présent dans le tas.
+ * Complexité: O(1)
+ */
+extern int iheap_contains(IHeap *h, int id);
+
+/* iheap_get -- renvoie la donnée associée à id, ou NULL si id n'est
+ * pas dans le tas.
+ * Complexité: O(1)
+ */
+extern void *iheap_get(IHeap *h, int id);
+
+/* iheap_root -- renvoie la donnée placée à la racine du tas (ie son
+ * plus "petit" élément). Ne modifie PAS le tas.
+ * Complexité: O(1)
+ */
+extern void *iheap_root(IHeap *h);
+
+/* iheap_root_id -- renvoie l'identifiant de la racine du tas, ou -1 si
+ * le tas est vide.
+ * Complexité: O(1)
+ */
+extern int iheap_root_id(IHeap *h);
+
+/* iheap_extract_root -- retire la racine du tas et renvoie son
+ * identifiant (-1 si le tas est vide). Si item n'est pas NULL, la donnée
+ * associée y est recopiée.
+ * Complexité: O(ln(iheap_size(h)))
+ */
+extern int iheap_extract_root(IHeap *h, void **item);
+
+/* iheap_insert -- insère l'élément id, de donnée item, dans le tas.
+ * La valeur de retour indique si l'insertion s'est bien passée (0 si
+ * id est invalide ou déjà présent).
+ * Complexité: O(ln(iheap_size(h)))
+ */
+extern int iheap_insert(IHeap *h, int id, void *item);
+
+/* iheap_decrease_key -- remplace la donnée associée à id par item, qui
+ * ne doit pas etre plus "grande" que l'ancienne.
+ * La valeur de retour indique si id était présent.
+ * Complexité: O(ln(iheap_size(h)))
+ */
+extern int iheap_decrease_key(IHeap *h, int id, void *item);
+
+/* iheap_increase_key -- remplace la donnée associée à id par item, qui
+ * ne doit pas etre plus "petite" que l'ancienne.
+ * La valeur de retour indique si id était présent.
+ * Complexité: O(ln(iheap_size(h)))
+ */
+extern int iheap_increase_key(IHeap *h, int id, void *item);
+
+/* iheap_update -- remplace la donnée associée à id par item, quel que
+ * soit le sens de la modification.
+ * La valeur de retour indique si id était présent.
+ * Complexité: O(ln(iheap_size(h)))
+ */
+extern int iheap_update(IHeap *h, int id, void *item);
+
+/* iheap_remove -- retire l'élément id du tas.
+ * La valeur de retour indique si id était présent.
+ * Complexité: O(ln(iheap_size(h)))
+ */
+extern int iheap_remove(IHeap *h, int id);
+
+/* iheap_print -- affiche le tas à l'écran. Affiche chacun des
+ * éléments avec la fonction print_data.
+ * Complexité: O(iheap_size(h))
+ */
+extern void iheap_print(IHeap *h, void (*print_data)(void *));
+
+#endif /* IHEAP_H */
@@ -0,0 +1,205 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+
+#include "intern.h"
+#include "hashfn.h"
+
+/* Nombre de copies d'étiquettes entières par slab */
+#define INTERN_SLAB_ITEMS 512
+
+/* intern_new -- crée une table d'identifiants vide, pour des étiquettes
+ * de type kind. max_size est une estimation du nombre d'étiquettes; la
+ * table s'agrandit si nécessaire.
+ * Retourne un pointeur sur cette table, ou NULL en cas d'échec.
+ * Complexité: O(max_size)
+ */
+Intern *intern_new(int max_size, int kind)
+{
+  Intern *tmp;
+
+  assert((max_size > 0) && ((kind == INTERN_STRING) || (kind == INTERN_U64)));
+  if ((tmp = (Intern *) malloc(sizeof(Intern))) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "intern_new: erreur d'allocation mémoire.\n");
+#endif
+    return NULL;
+  }
+  tmp->kind = kind;
+  tmp->size = 0;
+  tmp->max = max_size;
+  tmp->u64s = NULL;
+  tmp->labels = (void **) malloc(max_size*sizeof(void *));
+  if (kind == INTERN_STRING)
+    tmp->table = ohash_table_new(max_size, hash_string_key, hash_string_equal);
+  else {
+    tmp->table = ohash_table_new(max_size, hash_u64_key, hash_u64_equal);
+    tmp->u64s = pool_new(sizeof(uint64_t), INTERN_SLAB_ITEMS);
+  }
+  if ((tmp->labels == NULL) || (tmp->table == NULL) ||
+      ((kind == INTERN_U64) && (tmp->u64s == NULL))) {
+#ifdef DEBUG
+    fprintf(stderr, "intern_new: erreur d'allocation mémoire.\n");
+#endif
+    intern_free(tmp);
+    return NULL;
+  }
+  return tmp;
+}
+
+/* intern_free -- détruit une table d'identifiants et libère la mémoire
+ * qu'elle occupait (y compris les copies des étiquettes).
+ * Complexité: O(intern_size(in))
+ */
+void intern_free(Intern *in)
+{
+  int i;
+
+  assert(in != NULL);
+  if (in->kind == INTERN_STRING)
+    for (i = 0; i < in->size; i++)
+      free(in->labels[i]);
+  if (in->u64s != NULL) pool_free(in->u64s);
+  if (in->table != NULL) ohash_table_free(in->table);
+  free(in->labels);
+  free(in);
+}
+
+/* intern_size -- renvoie le nombre d'étiquettes de la table (les
+ * numéros vont de 0 à intern_size(in)-1).
+ * Complexité: O(1)
+ */
+int intern_size(Intern *in)
+{
+  assert(in != NULL);
+  return in->size;
+}
+
+/* intern_lookup (fonction interne) -- renvoie le numéro de la clé key
+ * (une chaine, ou un pointeur sur un uint64_t), ou -1 si elle est absente.
+ * Complexité: O(1) en moyenne
+ */
+static int intern_lookup(Intern *in, void *key)
+{
+  void *id = ohash_table_find(in->table, key);
+
+  /* Les données de la table sont les numéros décalés de 1, pour ne
+   * jamais etre NULL.
+   */
+  return (id == NULL) ? -1 : (int) ((intptr_t) id - 1);
+}
+
+/* intern_add (fonction interne) -- attribue le numéro suivant à key,
+ * qui doit etre une copie appartenant à la table et absente de celle-ci.
+ * Renvoie ce numéro, ou -1 en cas d'erreur d'allocation mémoire.
+ * Complexité: O(1) amortie
+ */
+static int intern_add(Intern *in, void *key)
+{
+  void **labels;
+
+  if (in->size == in->max) {
+    if ((labels = (void **) realloc(in->labels, 2*in->max*sizeof(void *))) == NULL) {
+#ifdef DEBUG
+      fprintf(stderr, "intern_add: erreur d'allocation mémoire.\n");
+#endif
+      return -1;
+    }
+    in->labels = labels;
+    in->max *= 2;
+  }
+  if (!ohash_table_insert(in->table, key, (void *) (intptr_t) (in->size + 1)))
+    return -1;
+  in->labels[in->size] = key;
+  return in->size++;
+}
+
+/* intern_string -- renvoie le numéro de la chaine label, en lui en
+ * attribuant un nouveau si elle n'a jamais été vue.
+ * Renvoie -1 en cas d'erreur d'allocation mémoire.
+ * Complexité: O(longueur(label)) en moyenne
+ */
+int intern_string(Intern *in, const char *label)
+{
+  char *copy;
+  size_t len;
+  int id;
+
+  assert((in != NULL) && (in->kind == INTERN_STRING) && (label != NULL));
+  if ((id = intern_lookup(in, (void *) label)) != -1)
+    return id;
+  len = strlen(label) + 1;
+  if ((copy = (char *) malloc(len)) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "intern_string: erreur d'allocation mémoire.\n");
+#endif
+    return -1;
+  }
+  memcpy(copy, label, len);
+  if ((id = intern_add(in, copy)) == -1)
+    free(copy);
+  return id;
+}
+
+/* intern_u64 -- renvoie le numéro de l'entier label, en lui en
+ * attribuant un nouveau s'il n'a jamais été vu.
+ * Renvoie -1 en cas d'erreur d'allocation mémoire.
+ * Complexité: O(1) en moyenne
+ */
+int intern_u64(Intern *in, uint64_t label)
+{
+  uint64_t *copy;
+  int id;
+
+  assert((in != NULL) && (in->kind == INTERN_U64));
+  if ((id = intern_lookup(in, &label)) != -1)
+    return id;
+  if ((copy = (uint64_t *) pool_alloc(in->u64s)) == NULL)
+    return -1;
+  *copy = label;
+  if ((id = intern_add(in, copy)) == -1)
+    pool_release(in->u64s, copy);
+  return id;
+}
+
+/* intern_find_string -- renvoie le numéro de la chaine label, ou -1 si
+ * elle n'est pas dans la table.
+ * Complexité: O(longueur(label)) en moyenne
+ */
+int intern_find_string(Intern *in, const char *label)
+{
+  assert((in != NULL) && (in->kind == INTERN_STRING) && (label != NULL));
+  return intern_lookup(in, (void *) label);
+}
+
+/* intern_find_u64 -- renvoie le numéro de l'entier label, ou -1 s'il
+ * n'est pas dans la table.
+ * Complexité: O(1) en moyenne
+ */
+int intern_find_u64(Intern *in, uint64_t label)
+{
+  assert((in != NULL) && (in->kind == INTERN_U64));
+  return intern_lookup(in, &label);
+}
+
+/* intern_string_label -- renvoie la chaine de numéro id.
+ * Complexité: O(1)
+ */
+const char *intern_string_label(Intern *in, int id)
+{
+  assert((in != NULL) && (in->kind == INTERN_STRING) &&
+         (id >= 0) && (id < in->size));
+  return (const char *) in->labels[id];
+}
+
+/* intern_u64_label -- renvoie l'entier de numéro id.
+ * Complexité: O(1)
+ */
+uint64_t intern_u64_label(Intern *in, int id)
+{
+  assert((in != NULL) && (in->kind == INTERN_U64) &&
+         (id >= 0) && (id < in->size));
+  return *(uint64_t *) in->labels[id];
+}
@@ -0,0 +1,87 @@
+#ifndef INTERN_H
+#define INTERN_H
+
+#include <stdint.h>
+
+#include "ohash.h"
+#include "pool.h"
+
+/* Table d'identifiants: associe à chaque étiquette (chaine de
+ * caractères, ou entier de 64 bits quelconque) un numéro dense, attribué
+ * dans l'ordre d'apparition à partir de 0. Cela permet de lire un graphe
+ * dont les sommets portent des noms quelconques, de le ranger dans des
+ * tableaux de la taille exacte du nombre de sommets, puis de retrouver
+ * le nom de chaque sommet à partir de son numéro.
+ * Une table ne contient qu'un seul type d'étiquettes, choisi à la
+ * création (INTERN_STRING ou INTERN_U64). Les chaines sont recopiées.
+ */
+
+#define INTERN_STRING 0
+#define INTERN_U64    1
+
+typedef struct {
+  int kind;                     /* INTERN_STRING ou INTERN_U64 */
+  int size;                     /* Nombre d'étiquettes */
+  int max;                      /* Taille du tableau labels */
+  OHashTable *table;            /* Étiquette -> numéro + 1 */
+  void **labels;                /* labels[id] = étiquette de numéro id */
+  Pool *u64s;                   /* Copies des étiquettes entières */
+} Intern;
+
+/* intern_new -- crée une table d'identifiants vide, pour des étiquettes
+ * de type kind. max_size est une estimation du nombre d'étiquettes; la
+ * table s'agrandit si nécessaire.
+ * Retourne un pointeur sur cette table, ou NULL en cas d'échec.
+ * Complexité: O(max_size)
+ */
+extern Intern *intern_new(int max_size, int kind);
+
+/* intern_free -- détruit une table d'identifiants et libère la mémoire
+ * qu'elle occupait (y compris les copies des étiquettes).
+ * Complexité: O(intern_size(in))
+ */
+extern void intern_free(Intern *in);
+
+/* intern_size -- renvoie le nombre d'étiquettes de la table (les
+ * numéros vont de 0 à intern_size(in)-1).
+ * Complexité: O(1)
+ */
+extern int intern_size(Intern *in);
+
+/* intern_string -- renvoie le numéro de la chaine label, en lui en
+ * attribuant un nouveau si elle n'a jamais été vue.
+ * Renvoie -1 en cas d'erreur d'allocation mémoire.
+ * Complexité: O(longueur(label)) en moyenne
+ */
+extern int intern_string(Intern *in, const char *label);
+
+/* intern_u64 -- renvoie le numéro de l'entier label, en lui en
+ * attribuant un nouveau s'il n'a jamais été vu.
+ * Renvoie -1 en cas d'erreur d'allocation mémoire.
+ * Complexité: O(1) en moyenne
+ */
+extern int intern_u64(Intern *in, uint64_t label);
+
+/* intern_find_string -- renvoie le numéro de la chaine label, ou -1 si
+ * elle n'est pas dans la table.
+ * Complexité: O(longueur(label)) en moyenne
+ */
+extern int intern_find_string(Intern *in, const char *label);
+
+/* intern_find_u64 -- renvoie le numéro de l'entier label, ou -1 s'il
+ * n'est pas dans la table.
+ * Complexité: O(1) en moyenne
+ */
+extern int intern_find_u64(Intern *in, uint64_t label);
+
+/* intern_string_label -- renvoie la chaine de numéro id.
+ * Complexité: O(1)
+ */
+extern const char *intern_string_label(Intern *in, int id);
+
+/* intern_u64_label -- renvoie l'entier de numéro id.
+ * Complexité: O(1)
+ */
+extern uint64_t intern_u64_label(Intern *in, int id);
+
+#endif /* INTERN_H */
@@ -0,0 +1,57 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "kheap.h"
+
+/* Choix du plus petit des 4 fils d'un noeud.
+ * Avec SSE2, les 4 clés sont chargées dans un registre, le minimum est
+ * obtenu par deux échanges de moitiés, puis retrouvé par une comparaison
+ * d'égalité: la première position qui correspond est renvoyée.
+ */
+#ifdef __SSE2__
+static inline int kheap_first_bit(int mask)
+{
+  return (mask & 1) ? 0 : (mask & 2) ? 1 : (mask & 4) ? 2 : 3;
+}
+
+static inline int fheap_min4(const float *k)
+{
+  __m128 v = _mm_loadu_ps(k);
+  __m128 m = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+
+  m = _mm_min_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+  return kheap_first_bit(_mm_movemask_ps(_mm_cmpeq_ps(v, m)));
+}
+
+/* SSE2 n'a pas d'instruction min sur les entiers 32 bits: on la simule
+ * avec un masque de comparaison.
+ */
+static inline __m128i kheap_min_epi32(__m128i a, __m128i b)
+{
+  __m128i lt = _mm_cmplt_epi32(a, b);
+  return _mm_or_si128(_mm_and_si128(lt, a), _mm_andnot_si128(lt, b));
+}
+
+static inline int i32heap_min4(const int32_t *k)
+{
+  __m128i v = _mm_loadu_si128((const __m128i *) k);
+  __m128i m = kheap_min_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+
+  m = kheap_min_epi32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2)));
+  return kheap_first_bit(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(v, m))));
+}
+#else
+KHEAP_SCALAR_MIN4(fheap_min4, float)
+KHEAP_SCALAR_MIN4(i32heap_min4, int32_t)
+#endif
+
+/* Pas de comparaison 64 bits non signée en SSE2: version scalaire */
+KHEAP_SCALAR_MIN4(u64heap_min4, uint64_t)
+
+KHEAP_DEFINE(FloatHeap, fheap, float, fheap_min4)
+KHEAP_DEFINE(Int32Heap, i32heap, int32_t, i32heap_min4)
+KHEAP_DEFINE(UInt64Heap, u64heap, uint64_t, u64heap_min4)
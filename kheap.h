@@ -0,0 +1,245 @@
+#ifndef KHEAP_H
+#define KHEAP_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+
+/* Tas à clés typées. Contrairement à Heap, les clés sont rangées
+ * directement dans le tas (dans un tableau séparé des données) et
+ * comparées par l'opérateur < du type, sans passer par un pointeur de
+ * fonction. Le tas est 4-aire: les 4 fils d'un noeud sont contigus en
+ * mémoire, ce qui permet de chercher le plus petit d'entre eux en une
+ * seule comparaison vectorielle.
+ *
+ * KHEAP_DECLARE(Name, prefix, type) déclare le type Name et les fonctions
+ * prefix_xxx pour des clés de type type. KHEAP_DEFINE(Name, prefix, type,
+ * min4) les définit; min4 est une fonction de signature
+ * int min4(const type *k) qui renvoie l'indice (entre 0 et 3) de la plus
+ * petite des 4 clés k[0..3]. KHEAP_SCALAR_MIN4 en fournit une version
+ * générique.
+ *
+ * Les clés doivent etre totalement ordonnées par < (pas de NaN).
+ */
+
+#define KHEAP_ARITY 4
+#define kheap_first_son(i) (KHEAP_ARITY*(i)+1)
+#define kheap_father(i) (((i)-1)/KHEAP_ARITY) /* FAUX si i == 0 */
+
+#define KHEAP_DECLARE(Name, prefix, type)                                     \
+typedef struct {                                                              \
+  int size;                     /* Taille effective du tas */                 \
+  int max;                      /* Taille du tableau */                       \
+  type *keys;                   /* Les clés */                                \
+  void **items;                 /* Les données associées aux clés */          \
+} Name;                                                                       \
+                                                                              \
+extern Name *prefix##_create(int max_size);                                   \
+extern Name *prefix##_build(type *keys, void **items, int size, int max_size); \
+extern void prefix##_free(Name *h);                                           \
+extern int prefix##_size(Name *h);                                            \
+extern int prefix##_max_size(Name *h);                                        \
+extern type prefix##_root_key(Name *h);                                       \
+extern void *prefix##_root(Name *h);                                          \
+extern void *prefix##_extract_root(Name *h);                                  \
+extern int prefix##_insert(Name *h, type key, void *item);
+
+/* KHEAP_SCALAR_MIN4 -- définit la fonction min4 générique (sans branchement)
+ * pour le type type.
+ */
+#define KHEAP_SCALAR_MIN4(min4, type)                                         \
+static inline int min4(const type *k)                                         \
+{                                                                             \
+  int a = (k[1] < k[0]);                                                      \
+  int b = 2 + (k[3] < k[2]);                                                  \
+  return (k[b] < k[a]) ? b : a;                                               \
+}
+
+#define KHEAP_DEFINE(Name, prefix, type, min4)                                \
+/* prefix_create -- crée un tas d'une taille initiale donnée. Le tas          \
+ * s'agrandit automatiquement si nécessaire.                                  \
+ * Retourne un pointeur sur ce nouveau tas, ou NULL en cas d'échec.           \
+ * Complexité: O(1)                                                           \
+ */                                                                           \
+Name *prefix##_create(int max_size)                                           \
+{                                                                             \
+  type *keys;                                                                 \
+  void **items;                                                               \
+  Name *tmp;                                                                  \
+                                                                              \
+  assert(max_size > 0);                                                       \
+  keys = (type *) malloc(max_size*sizeof(type));                              \
+  items = (void **) malloc(max_size*sizeof(void *));                          \
+  if ((keys == NULL) || (items == NULL) ||                                    \
+      ((tmp = prefix##_build(keys, items, 0, max_size)) == NULL)) {           \
+    free(keys);                                                               \
+    free(items);                                                              \
+    return NULL;                                                              \
+  }                                                                           \
+  return tmp;                                                                 \
+}                                                                             \
+                                                                              \
+/* prefix_shift_down (fonction interne) -- fait descendre à sa place          \
+ * l'élément situé en position i.                                             \
+ * Complexité: O(ln(prefix_size(h)))                                          \
+ */                                                                           \
+static void prefix##_shift_down(Name *h, int i)                               \
+{                                                                             \
+  type key = h->keys[i];                                                      \
+  void *item = h->items[i];                                                   \
+  int c, m, j;                                                                \
+                                                                              \
+  while ((c = kheap_first_son(i)) < h->size) {                                \
+    /* Détermine le plus petit des fils */                                    \
+    if (c + KHEAP_ARITY <= h->size)                                           \
+      m = c + min4(h->keys + c);                                              \
+    else                                                                      \
+      for (m = c, j = c + 1; j < h->size; j++)                                \
+        if (h->keys[j] < h->keys[m]) m = j;                                   \
+    if (!(h->keys[m] < key))                                                  \
+      break;                                                                  \
+    h->keys[i] = h->keys[m];                                                  \
+    h->items[i] = h->items[m];                                                \
+    i = m;                                                                    \
+  }                                                                           \
+  h->keys[i] = key;                                                           \
+  h->items[i] = item;                                                         \
+}                                                                             \
+                                                                              \
+/* prefix_build -- crée un tas à partir des size premiers éléments des        \
+ * tableaux keys et items, de taille max_size. Comme pour heap_build, les     \
+ * tableaux ne sont pas recopiés: ils doivent avoir été alloués par malloc    \
+ * et appartiennent ensuite au tas.                                           \
+ * En cas d'échec, renvoie NULL et les tableaux restent à l'appelant.         \
+ * Complexité: O(size)                                                        \
+ */                                                                           \
+Name *prefix##_build(type *keys, void **items, int size, int max_size)        \
+{                                                                             \
+  Name *tmp;                                                                  \
+  int i;                                                                      \
+                                                                              \
+  assert((keys != NULL) && (items != NULL) && (size >= 0) &&                  \
+         (max_size > 0) && (size <= max_size));                               \
+  if ((tmp = (Name *) malloc(sizeof(Name))) == NULL) {                        \
+    return NULL;                                                              \
+  }                                                                           \
+  tmp->keys = keys;                                                           \
+  tmp->items = items;                                                         \
+  tmp->size = size;                                                           \
+  tmp->max = max_size;                                                        \
+  if (size > 1)                                                               \
+    for (i = kheap_father(size-1); i >= 0; i--)                               \
+      prefix##_shift_down(tmp, i);                                            \
+  return tmp;                                                                 \
+}                                                                             \
+                                                                              \
+/* prefix_free -- détruit un tas et libère la mémoire qu'il occupait.         \
+ * Complexité: O(1)                                                           \
+ */                                                                           \
+void prefix##_free(Name *h)                                                   \
+{                                                                             \
+  assert(h != NULL);                                                          \
+  free(h->keys);                                                              \
+  free(h->items);                                                             \
+  free(h);                                                                    \
+}                                                                             \
+                                                                              \
+/* prefix_size -- renvoie le nombre d'éléments du tas.                        \
+ * Complexité: O(1)                                                           \
+ */                                                                           \
+int prefix##_size(Name *h)                                                    \
+{                                                                             \
+  assert(h != NULL);                                                          \
+  return h->size;                                                             \
+}                                                                             \
+                                                                              \
+/* prefix_max_size -- renvoie le nombre d'éléments que le tas peut            \
+ * contenir sans avoir à s'agrandir.                                          \
+ * Complexité: O(1)                                                           \
+ */                                                                           \
+int prefix##_max_size(Name *h)                                                \
+{                                                                             \
+  assert(h != NULL);                                                          \
+  return h->max;                                                              \
+}                                                                             \
+                                                                              \
+/* prefix_root_key -- renvoie la plus petite clé du tas.                      \
+ * Complexité: O(1)                                                           \
+ */                                                                           \
+type prefix##_root_key(Name *h)                                               \
+{                                                                             \
+  assert((h != NULL) && (h->size != 0));                                      \
+  return h->keys[0];                                                          \
+}                                                                             \
+                                                                              \
+/* prefix_root -- renvoie la donnée associée à la plus petite clé du tas.     \
+ * Ne modifie PAS le tas.                                                     \
+ * Complexité: O(1)                                                           \
+ */                                                                           \
+void *prefix##_root(Name *h)                                                  \
+{                                                                             \
+  assert((h != NULL) && (h->size != 0));                                      \
+  return h->items[0];                                                         \
+}                                                                             \
+                                                                              \
+/* prefix_extract_root -- retire la racine du tas et renvoie la donnée        \
+ * associée, ou NULL si le tas est vide.                                      \
+ * Complexité: O(ln(prefix_size(h)))                                          \
+ */                                                                           \
+void *prefix##_extract_root(Name *h)                                          \
+{                                                                             \
+  void *tmp;                                                                  \
+                                                                              \
+  assert(h != NULL);                                                          \
+  if (h->size == 0) return NULL;                                              \
+  tmp = h->items[0];                                                          \
+  h->size -= 1;                                                               \
+  if (h->size > 0) {                                                          \
+    h->keys[0] = h->keys[h->size];                                            \
+    h->items[0] = h->items[h->size];                                          \
+    prefix##_shift_down(h, 0);                                                \
+  }                                                                           \
+  return tmp;                                                                 \
+}                                                                             \
+                                                                              \
+/* prefix_insert -- insère la donnée item avec la clé key. Si le tas est      \
+ * plein, sa taille est doublée.                                              \
+ * La valeur de retour indique si l'insertion s'est bien passée.              \
+ * Complexité: O(ln(prefix_size(h))) amortie                                  \
+ */                                                                           \
+int prefix##_insert(Name *h, type key, void *item)                            \
+{                                                                             \
+  type *keys;                                                                 \
+  void **items;                                                               \
+  int i, f;                                                                   \
+                                                                              \
+  assert(h != NULL);                                                          \
+  if (h->size == h->max) {                                                    \
+    if ((keys = (type *) realloc(h->keys, 2*h->max*sizeof(type))) == NULL)    \
+      return 0;                                                               \
+    h->keys = keys;                                                           \
+    if ((items = (void **) realloc(h->items, 2*h->max*sizeof(void *))) == NULL) \
+      return 0;                                                               \
+    h->items = items;                                                         \
+    h->max *= 2;                                                              \
+  }                                                                           \
+  /* Remonte le trou jusqu'à la place de la nouvelle clé */                   \
+  for (i = h->size; i > 0; i = f) {                                           \
+    f = kheap_father(i);                                                      \
+    if (!(key < h->keys[f]))                                                  \
+      break;                                                                  \
+    h->keys[i] = h->keys[f];                                                  \
+    h->items[i] = h->items[f];                                                \
+  }                                                                           \
+  h->keys[i] = key;                                                           \
+  h->items[i] = item;                                                         \
+  h->size += 1;                                                               \
+  return 1;                                                                   \
+}
+
+/* Instanciations pour les types de clés courants */
+KHEAP_DECLARE(FloatHeap, fheap, float)
+KHEAP_DECLARE(Int32Heap, i32heap, int32_t)
+KHEAP_DECLARE(UInt64Heap, u64heap, uint64_t)
+
+#endif /* KHEAP_H */
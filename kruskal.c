@@ -9,19 +9,16 @@
 
 /* Structures de données nécessaires pour les algorithmes */
 #include "dsets.h"
-#include "heap.h"
+#include "kheap.h"
 #include "fifo.h"
+#include "intern.h"
+
+/* Taille maximale d'une ligne du fichier d'entrée */
+#define LINE_SIZE 1024
 
 /* Permet de suivre le déroulement des algorithmes (si verbose != 0) */
 static int verbose = 0;
 
-/* La relation utilisée pour ordonner les aretes dans le tas */
-int edge_relation(void *e1, void *e2)
-{
-  assert((e1 != NULL) && (e2 != NULL));
-  return (((Edge *) e1)->weight >= ((Edge *) e2)->weight);
-}
-
 /* kruskal -- Applique l'algorithme de Kruskal sur le graphe g. En
  * sortie, les aretes de g qui appartiennent à l'Arbre Couvrant
  * Minimum sont coloriées en bleu (attr == BLUE) , et les autres en
@@ -29,52 +26,69 @@ int edge_relation(void *e1, void *e2)
  */
 void kruskal(Graph *g)
 {
-  Heap *h;                      /* Tas utilisé pour trier les aretes */
+  FloatHeap *h;                 /* Tas utilisé pour trier les aretes */
   DSets *groups;                /* Groupes de sommets reliés */
   Edge *current;                /* Arete en cours de traitement */
+  float *weights, *wtmp;        /* Poids des aretes, clés du futur tas */
+  void **edges, **etmp;         /* Tableau des aretes, données du futur tas */
+  int nb_edges, max_edges;      /* Nombre d'aretes et taille des tableaux */
   int size = graph_max_size(g); /* Taille de g (nb de sommets) */
-  int i;
 
   assert((g != NULL) && (size > 0));
   if (verbose) printf("Entrée dans kruskal:\n\tInitialisations...\n");
 
   /* Crée les structures */
-  /* Note: la taille de h (size*size) n'est pas optimale, mais
-   * le calcul du nombre exact d'aretes prendrait trop de temps.
-   */
-  if (((h = heap_create(size*size, edge_relation)) == NULL) ||
+  max_edges = size;
+  if (((weights = (float *) malloc(max_edges*sizeof(float))) == NULL) ||
+      ((edges = (void **) malloc(max_edges*sizeof(void *))) == NULL) ||
       ((groups = dsets_new(size)) == NULL)) {
     fprintf(stderr, "kruskal: erreur d'allocation mémoire.\n");
     exit(1);
   }
 
-  /* Initialise les groupes de sommets */
-  for (i = 0; i < size; i++)
-    if (graph_has_vertex(g, i))
-      dsets_make_set(groups, i);
-
-  /* Remplie le tas avec les aretes et les colorie en rouge */
+  /* Récupère les aretes et les colorie en rouge. Le tableau est agrandi
+   * au besoin, ce qui évite d'avoir à le dimensionner à size*size.
+   */
+  nb_edges = 0;
   for (current = graph_first_edge(g);
        current != NULL;
        current = graph_next_edge(g, current))
     {
-      heap_insert(h, (void *) current);
+      if (nb_edges == max_edges) {
+        if (((wtmp = (float *) realloc(weights, 2*max_edges*sizeof(float))) == NULL) ||
+            ((etmp = (void **) realloc(edges, 2*max_edges*sizeof(void *))) == NULL)) {
+          fprintf(stderr, "kruskal: erreur d'allocation mémoire.\n");
+          exit(1);
+        }
+        weights = wtmp;
+        edges = etmp;
+        max_edges *= 2;
+      }
+      weights[nb_edges] = edge_get_weight(current);
+      edges[nb_edges++] = (void *) current;
       edge_set_attr(current, RED);
     }
 
+  /* Construit le tas en une seule passe, en O(nb_edges). Les poids sont
+   * recopiés dans le tas: les comparaisons n'ont plus à lire les aretes.
+   */
+  if ((h = fheap_build(weights, edges, nb_edges, max_edges)) == NULL) {
+    fprintf(stderr, "kruskal: erreur d'allocation mémoire.\n");
+    exit(1);
+  }
+
   if (verbose) printf("\tDébut du traitement.\n");
 
   /* Traite les aretes dans l'ordre */
-  while (heap_size(h) != 0) {
-    current = (Edge *) heap_extract_root(h);
+  while (fheap_size(h) != 0) {
+    current = (Edge *) fheap_extract_root(h);
     if (verbose) {
       printf("\tArete faible: ");
       edge_print(current);
       putchar('\n');
     }
-    if (!dsets_same_set(groups, current->v1, current->v2)) {
+    if (dsets_union(groups, current->v1, current->v2)) {
       edge_set_attr(current, BLUE);
-      dsets_union(groups, current->v1, current->v2);
       if (verbose) {
         printf("\tArete sélectionnée => ");
         printf("Union: %d U %d\n", current->v1, current->v2);
@@ -82,14 +96,14 @@ void kruskal(Graph *g)
     }
   }
   if (verbose) printf("Sortie de kruskal.\n");
-  heap_free(h);
+  fheap_free(h);
   dsets_free(groups);
 }
 
 /* print_edges -- affiche les aretes de g sous une forme à peu près
- * lisible.
+ * lisible, en désignant les sommets par leurs noms.
  */
-void print_edges(Graph *g)
+void print_edges(Graph *g, Intern *names)
 {
   Edge *current;
 
@@ -99,7 +113,8 @@ void print_edges(Graph *g)
        current != NULL;
        current = graph_next_edge(g, current))
     {
-      edge_print(current);
+      edge_print_labels(current, intern_string_label(names, current->v1),
+                        intern_string_label(names, current->v2));
       putchar('\n');
     }
 }
@@ -108,7 +123,9 @@ void bfs_visit(Graph *g, int i, int mark[], int parent[])
 {
   int size = graph_max_size(g);
   Vertex u;
-  int k, n;
+  void **first, **second;       /* Sommets en attente, en place dans la file */
+  int first_len, second_len, len;
+  int j, k, n;
   Fifo *f = fifo_new(size);
   
   if (verbose) 
@@ -117,26 +134,32 @@ void bfs_visit(Graph *g, int i, int mark[], int parent[])
   mark[i] = 1;
   fifo_put(f, (void *) g->vertex[i]);
   
-  while (!fifo_empty(f)) {
-    /* Retire un sommet */
-    u = (Vertex) fifo_get(f);
-    /* Parcours ses successeurs */
-    for (k = 0; k < size; k++)
-      if (u[k] != NULL) {
-        if ((!mark[k]) && (edge_get_attr(u[k]) == BLUE)) {
-          /* Calcule le numéro du sommet en cours */
-          n = (u[k]->v1 == k) ? u[k]->v2 : u[k]->v1;
-          /* Enfile le successeur */
-          fifo_put(f, (void *) g->vertex[k]);
-          /* Traitement */
-          mark[k] = 1;
-          parent[k] = n;
-          if (verbose) {
-            printf("\t\tInsertion dans la file: %d\n", k);
-            printf("\t\tpère[%d] <= %d\n", k, n);
+  /* Traite en place, sans les recopier, tous les sommets en attente;
+   * ceux qu'on enfile pendant ce temps seront traités au tour suivant.
+   */
+  while ((len = fifo_peek(f, &first, &first_len, &second, &second_len)) != 0) {
+    for (j = 0; j < len; j++) {
+      u = (Vertex) ((j < first_len) ? first[j] : second[j - first_len]);
+      /* Parcours ses successeurs */
+      for (k = 0; k < size; k++)
+        if (u[k] != NULL) {
+          if ((!mark[k]) && (edge_get_attr(u[k]) == BLUE)) {
+            /* Calcule le numéro du sommet en cours */
+            n = (u[k]->v1 == k) ? u[k]->v2 : u[k]->v1;
+            /* Enfile le successeur */
+            fifo_put(f, (void *) g->vertex[k]);
+            /* Traitement */
+            mark[k] = 1;
+            parent[k] = n;
+            if (verbose) {
+              printf("\t\tInsertion dans la file: %d\n", k);
+              printf("\t\tpère[%d] <= %d\n", k, n);
+            }
           }
         }
-      }
+    }
+    /* Retire d'un coup les sommets traités */
+    fifo_consume(f, len);
   }
   if (verbose) printf("\tSortie de BFS_visit.\n");
 }
@@ -168,50 +191,101 @@ void bfs(Graph *g, int *parent)
 int main(int argc, char *argv[])
 {
   Graph *g;
+  Intern *names;                /* Noms des sommets <-> numéros */
   int *parent;
-  char line[30];
-  int i, size, v1, v2;
+  char line[LINE_SIZE];
+  char l1[LINE_SIZE], l2[LINE_SIZE];
+  int *ends, *etmp;             /* Extrémités des aretes lues */
+  float *weights, *wtmp;        /* Poids des aretes lues */
+  int nb_edges = 0, max_edges = 64;
+  int i, n, size, first = 1;
   float w;
 
   /* Lecture des arguments */
   if ((argc == 2) && strcmp(argv[1], "-v") == 0)
     verbose = 1;
 
-  /* Première ligne: nombre de sommets */
-  fgets(line, 30, stdin);
-  sscanf(line, "%d", &size);
-  if ((g = graph_new(size)) == NULL) {
-    fprintf(stderr, "kruskal: erreur de la création du graphe (%d sommets).\n", size);
+  if (((names = intern_new(64, INTERN_STRING)) == NULL) ||
+      ((ends = (int *) malloc(2*max_edges*sizeof(int))) == NULL) ||
+      ((weights = (float *) malloc(max_edges*sizeof(float))) == NULL)) {
+    fprintf(stderr, "kruskal: erreur d'allocation mémoire.\n");
     exit(1);
   }
-  parent = (int *) malloc(size*sizeof(int));
 
-  /* Lectures des aretes */
-  while (fgets(line, 30, stdin)) {
-    if (sscanf(line, "%d %d %f\n", &v1, &v2, &w) == EOF) {
+  /* Lectures des aretes. Les sommets sont désignés par des noms
+   * quelconques (sans espaces), numérotés au fur et à mesure qu'ils
+   * apparaissent: le graphe n'est créé qu'une fois tous les sommets
+   * connus, à la bonne taille. Une première ligne ne contenant qu'un mot
+   * (l'ancien format y donnait le nombre de sommets) est ignorée.
+   */
+  while (fgets(line, LINE_SIZE, stdin)) {
+    n = sscanf(line, "%s %s %f", l1, l2, &w);
+    if (first && (n == 1)) {
+      first = 0;
+      continue;
+    }
+    first = 0;
+    if (n != 3) {
       fprintf(stderr, "kruksal: erreur dans le format du fichier d'éntrée:\n");
       fprintf(stderr, "%s", line);
       exit(1);
     }
-    if (!graph_add_edge(g, v1, v2, w, WHITE)) {
-      fprintf(stderr, "kruskal: erreur lors de la création de l'arete (%d, %d).\n",
-              v1, v2);
+    if (nb_edges == max_edges) {
+      if (((etmp = (int *) realloc(ends, 4*max_edges*sizeof(int))) == NULL) ||
+          ((wtmp = (float *) realloc(weights, 2*max_edges*sizeof(float))) == NULL)) {
+        fprintf(stderr, "kruskal: erreur d'allocation mémoire.\n");
+        exit(1);
+      }
+      ends = etmp;
+      weights = wtmp;
+      max_edges *= 2;
+    }
+    if (((ends[2*nb_edges] = intern_string(names, l1)) == -1) ||
+        ((ends[2*nb_edges+1] = intern_string(names, l2)) == -1)) {
+      fprintf(stderr, "kruskal: erreur d'allocation mémoire.\n");
       exit(1);
     }
+    weights[nb_edges++] = w;
+  }
+
+  /* Construction du graphe */
+  if ((size = intern_size(names)) == 0) {
+    fprintf(stderr, "kruskal: le graphe est vide.\n");
+    exit(1);
   }
+  if ((g = graph_new(size)) == NULL) {
+    fprintf(stderr, "kruskal: erreur de la création du graphe (%d sommets).\n", size);
+    exit(1);
+  }
+  parent = (int *) malloc(size*sizeof(int));
+  for (i = 0; i < nb_edges; i++)
+    if (!graph_add_edge(g, ends[2*i], ends[2*i+1], weights[i], WHITE)) {
+      fprintf(stderr, "kruskal: erreur lors de la création de l'arete (%s, %s).\n",
+              intern_string_label(names, ends[2*i]),
+              intern_string_label(names, ends[2*i+1]));
+      exit(1);
+    }
+  free(ends);
+  free(weights);
 
   /* Début du traitement */
   kruskal(g);
   printf("\nRésultat après Kruskal:\n");
-  print_edges(g);
+  print_edges(g, names);
   putchar('\n');
 
   bfs(g, parent);
   printf("\nTableau des pères (après BFS):\n");
   for (i = 0; i < size; i++)
-    printf("père[%d] = %d\n", i, parent[i]);
+    if (parent[i] == -1)
+      printf("père[%s] = -1\n", intern_string_label(names, i));
+    else
+      printf("père[%s] = %s\n", intern_string_label(names, i),
+             intern_string_label(names, parent[i]));
 
   /* Libération des ressources */
   graph_free(g);
+  intern_free(names);
+  free(parent);
   return 0;
 }
@@ -0,0 +1,262 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+#include <sched.h>
+
+#include "mpmc.h"
+
+/* Nombre d'essais actifs avant de s'endormir */
+#define MPMC_SPIN 64
+
+/* mpmc_new -- crée une nouvelle file pouvant contenir au moins max_size
+ * éléments (la capacité est arrondie à la puissance de 2 supérieure, et
+ * vaut au moins 2).
+ * Retourne un pointeur sur cette file, ou NULL si l'allocation n'a pas
+ * pu se faire.
+ * Complexité: O(max_size)
+ */
+MpmcFifo *mpmc_new(int max_size)
+{
+  MpmcFifo *tmp;
+  size_t size, i;
+
+  assert(max_size > 0);
+  for (size = 2; size < (size_t) max_size; size *= 2)
+    ;
+  if (posix_memalign((void **) &tmp, MPMC_CACHE_LINE, sizeof(MpmcFifo)) != 0) {
+#ifdef DEBUG
+    fprintf(stderr, "mpmc_new: erreur d'allocation mémoire.\n");
+#endif
+    return NULL;
+  }
+  if ((tmp->slots = (MpmcSlot *) malloc(size*sizeof(MpmcSlot))) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "mpmc_new: erreur d'allocation mémoire.\n");
+#endif
+    free(tmp);
+    return NULL;
+  }
+  for (i = 0; i < size; i++) {
+    atomic_init(&tmp->slots[i].seq, i);
+    tmp->slots[i].item = NULL;
+  }
+  atomic_init(&tmp->head, 0);
+  atomic_init(&tmp->tail, 0);
+  tmp->mask = size - 1;
+  atomic_init(&tmp->waiting_get, 0);
+  atomic_init(&tmp->waiting_put, 0);
+  pthread_mutex_init(&tmp->lock, NULL);
+  pthread_cond_init(&tmp->not_empty, NULL);
+  pthread_cond_init(&tmp->not_full, NULL);
+  return tmp;
+}
+
+/* mpmc_free -- détruit une file et libère la mémoire qu'elle occupait.
+ * Aucun thread ne doit plus l'utiliser.
+ * Complexité: O(1)
+ */
+void mpmc_free(MpmcFifo *fifo)
+{
+  assert((fifo != NULL) && (fifo->slots != NULL));
+  pthread_cond_destroy(&fifo->not_full);
+  pthread_cond_destroy(&fifo->not_empty);
+  pthread_mutex_destroy(&fifo->lock);
+  free(fifo->slots);
+  free(fifo);
+}
+
+/* mpmc_max_size -- retourne le nombre maximum d'éléments que la file
+ * peut contenir.
+ * Complexité: O(1)
+ */
+int mpmc_max_size(MpmcFifo *fifo)
+{
+  assert(fifo != NULL);
+  return (int) (fifo->mask + 1);
+}
+
+/* mpmc_length -- retourne la longueur de la file. En présence d'autres
+ * threads, la valeur n'est qu'indicative.
+ * Complexité: O(1)
+ */
+int mpmc_length(MpmcFifo *fifo)
+{
+  size_t head, tail;
+
+  assert(fifo != NULL);
+  head = atomic_load_explicit(&fifo->head, memory_order_acquire);
+  tail = atomic_load_explicit(&fifo->tail, memory_order_acquire);
+  return (tail > head) ? (int) (tail - head) : 0;
+}
+
+/* mpmc_empty -- détermine si une file est vide (meme remarque que pour
+ * mpmc_length).
+ * Complexité: O(1)
+ */
+int mpmc_empty(MpmcFifo *fifo)
+{
+  return mpmc_length(fifo) == 0;
+}
+
+/* mpmc_push (fonction interne) -- insère item s'il reste de la place,
+ * sans réveiller personne.
+ * La valeur de retour indique si l'insertion s'est faite.
+ * Complexité: O(1) en l'absence de contention
+ */
+static int mpmc_push(MpmcFifo *fifo, void *item)
+{
+  MpmcSlot *slot;
+  size_t pos, seq;
+  intptr_t dif;
+
+  pos = atomic_load_explicit(&fifo->tail, memory_order_relaxed);
+  for (;;) {
+    slot = &fifo->slots[pos & fifo->mask];
+    seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+    dif = (intptr_t) seq - (intptr_t) pos;
+    if (dif == 0) {
+      /* Case libre: essaie de réserver la position */
+      if (atomic_compare_exchange_weak_explicit(&fifo->tail, &pos, pos + 1,
+                                                memory_order_relaxed,
+                                                memory_order_relaxed))
+        break;
+    } else if (dif < 0)
+      return 0;                 /* La case n'a pas encore été lue: pleine */
+    else
+      pos = atomic_load_explicit(&fifo->tail, memory_order_relaxed);
+  }
+  slot->item = item;
+  atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+  return 1;
+}
+
+/* mpmc_pop (fonction interne) -- retire un élément s'il y en a, sans
+ * réveiller personne.
+ * Retourne NULL si la file est vide.
+ * Complexité: O(1) en l'absence de contention
+ */
+static void *mpmc_pop(MpmcFifo *fifo)
+{
+  MpmcSlot *slot;
+  size_t pos, seq;
+  intptr_t dif;
+  void *item;
+
+  pos = atomic_load_explicit(&fifo->head, memory_order_relaxed);
+  for (;;) {
+    slot = &fifo->slots[pos & fifo->mask];
+    seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+    dif = (intptr_t) seq - (intptr_t) (pos + 1);
+    if (dif == 0) {
+      if (atomic_compare_exchange_weak_explicit(&fifo->head, &pos, pos + 1,
+                                                memory_order_relaxed,
+                                                memory_order_relaxed))
+        break;
+    } else if (dif < 0)
+      return NULL;              /* La case n'a pas encore été écrite: vide */
+    else
+      pos = atomic_load_explicit(&fifo->head, memory_order_relaxed);
+  }
+  item = slot->item;
+  atomic_store_explicit(&slot->seq, pos + fifo->mask + 1, memory_order_release);
+  return item;
+}
+
+/* mpmc_wake (fonction interne) -- réveille un thread endormi sur cond,
+ * s'il y en a un d'après waiting.
+ * La barrière fait pendant à celle de mpmc_put/mpmc_get: soit le thread endormi
+ * voit la modification de la file, soit on voit son compteur d'attente.
+ * Complexité: O(1)
+ */
+static void mpmc_wake(MpmcFifo *fifo, atomic_int *waiting, pthread_cond_t *cond)
+{
+  atomic_thread_fence(memory_order_seq_cst);
+  if (atomic_load_explicit(waiting, memory_order_relaxed) > 0) {
+    pthread_mutex_lock(&fifo->lock);
+    pthread_cond_signal(cond);
+    pthread_mutex_unlock(&fifo->lock);
+  }
+}
+
+/* mpmc_try_put -- insère un nouvel élément dans la file, sans attendre.
+ * La valeur de retour indique si l'insertion s'est faite (0 si la file
+ * est pleine).
+ * Complexité: O(1) en l'absence de contention
+ */
+int mpmc_try_put(MpmcFifo *fifo, void *item)
+{
+  assert((fifo != NULL) && (item != NULL));
+  if (!mpmc_push(fifo, item))
+    return 0;
+  mpmc_wake(fifo, &fifo->waiting_get, &fifo->not_empty);
+  return 1;
+}
+
+/* mpmc_try_get -- retire un élément de la file, sans attendre, et renvoie
+ * un pointeur sur son contenu.
+ * Retourne NULL si la file est vide.
+ * Complexité: O(1) en l'absence de contention
+ */
+void *mpmc_try_get(MpmcFifo *fifo)
+{
+  void *item;
+
+  assert(fifo != NULL);
+  if ((item = mpmc_pop(fifo)) != NULL)
+    mpmc_wake(fifo, &fifo->waiting_put, &fifo->not_full);
+  return item;
+}
+
+/* mpmc_put -- insère un nouvel élément dans la file, en attendant qu'une
+ * place se libère si elle est pleine.
+ * Complexité: O(1) en l'absence de contention
+ */
+void mpmc_put(MpmcFifo *fifo, void *item)
+{
+  int i;
+
+  assert((fifo != NULL) && (item != NULL));
+  for (i = 0; i < MPMC_SPIN; i++) {
+    if (mpmc_try_put(fifo, item))
+      return;
+    sched_yield();
+  }
+  pthread_mutex_lock(&fifo->lock);
+  atomic_fetch_add(&fifo->waiting_put, 1);
+  atomic_thread_fence(memory_order_seq_cst);
+  while (!mpmc_push(fifo, item))
+    pthread_cond_wait(&fifo->not_full, &fifo->lock);
+  atomic_fetch_sub(&fifo->waiting_put, 1);
+  /* On tient déjà le verrou: réveille directement un consommateur */
+  if (atomic_load(&fifo->waiting_get) > 0)
+    pthread_cond_signal(&fifo->not_empty);
+  pthread_mutex_unlock(&fifo->lock);
+}
+
+/* mpmc_get -- retire un élément de la file, en attendant qu'il en arrive
+ * un si elle est vide, et renvoie un pointeur sur son contenu.
+ * Complexité: O(1) en l'absence de contention
+ */
+void *mpmc_get(MpmcFifo *fifo)
+{
+  void *item;
+  int i;
+
+  assert(fifo != NULL);
+  for (i = 0; i < MPMC_SPIN; i++) {
+    if ((item = mpmc_try_get(fifo)) != NULL)
+      return item;
+    sched_yield();
+  }
+  pthread_mutex_lock(&fifo->lock);
+  atomic_fetch_add(&fifo->waiting_get, 1);
+  atomic_thread_fence(memory_order_seq_cst);
+  while ((item = mpmc_pop(fifo)) == NULL)
+    pthread_cond_wait(&fifo->not_empty, &fifo->lock);
+  atomic_fetch_sub(&fifo->waiting_get, 1);
+  if (atomic_load(&fifo->waiting_put) > 0)
+    pthread_cond_signal(&fifo->not_full);
+  pthread_mutex_unlock(&fifo->lock);
+  return item;
+}
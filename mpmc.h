@@ -0,0 +1,99 @@
+#ifndef MPMC_H
+#define MPMC_H
+
+#include <stddef.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+/* File bornée partagée par plusieurs producteurs et plusieurs
+ * consommateurs (algorithme de D. Vyukov).
+ * Chaque case porte un numéro de séquence qui indique si elle attend
+ * d'etre écrite (seq == position) ou lue (seq == position + 1). Un thread
+ * réserve une position par compare-and-swap sur tail (ou head), puis
+ * publie la case en mettant à jour son numéro de séquence: aucun verrou
+ * n'est pris tant que la file n'est ni pleine ni vide.
+ * Les variantes bloquantes attendent un peu activement, puis s'endorment
+ * sur une variable de condition; on ne réveille que s'il y a des threads
+ * endormis.
+ */
+
+#define MPMC_CACHE_LINE 64
+
+typedef struct {
+  atomic_size_t seq;            /* Numéro de séquence de la case */
+  void *item;
+} MpmcSlot;
+
+typedef struct {
+  _Alignas(MPMC_CACHE_LINE) atomic_size_t tail; /* Prochaine position à écrire */
+  _Alignas(MPMC_CACHE_LINE) atomic_size_t head; /* Prochaine position à lire */
+  _Alignas(MPMC_CACHE_LINE) size_t mask;        /* Capacité - 1 */
+  MpmcSlot *slots;              /* Les cases de la file */
+  /* Attente des variantes bloquantes */
+  atomic_int waiting_get;       /* Consommateurs endormis */
+  atomic_int waiting_put;       /* Producteurs endormis */
+  pthread_mutex_t lock;
+  pthread_cond_t not_empty;
+  pthread_cond_t not_full;
+} MpmcFifo;
+
+/* mpmc_new -- crée une nouvelle file pouvant contenir au moins max_size
+ * éléments (la capacité est arrondie à la puissance de 2 supérieure, et
+ * vaut au moins 2).
+ * Retourne un pointeur sur cette file, ou NULL si l'allocation n'a pas
+ * pu se faire.
+ * Complexité: O(max_size)
+ */
+extern MpmcFifo *mpmc_new(int max_size);
+
+/* mpmc_free -- détruit une file et libère la mémoire qu'elle occupait.
+ * Aucun thread ne doit plus l'utiliser.
+ * Complexité: O(1)
+ */
+extern void mpmc_free(MpmcFifo *fifo);
+
+/* mpmc_max_size -- retourne le nombre maximum d'éléments que la file
+ * peut contenir.
+ * Complexité: O(1)
+ */
+extern int mpmc_max_size(MpmcFifo *fifo);
+
+/* mpmc_length -- retourne la longueur de la file. En présence d'autres
+ * threads, la valeur n'est qu'indicative.
+ * Complexité: O(1)
+ */
+extern int mpmc_length(MpmcFifo *fifo);
+
+/* mpmc_empty -- détermine si une file est vide (meme remarque que pour
+ * mpmc_length).
+ * Complexité: O(1)
+ */
+extern int mpmc_empty(MpmcFifo *fifo);
+
+/* mpmc_try_put -- insère un nouvel élément dans la file, sans attendre.
+ * La valeur de retour indique si l'insertion s'est faite (0 si la file
+ * est pleine).
+ * Complexité: O(1) en l'absence de contention
+ */
+extern int mpmc_try_put(MpmcFifo *fifo, void *item);
+
+/* mpmc_try_get -- retire un élément de la file, sans attendre, et renvoie
+ * un pointeur sur son contenu.
+ * Retourne NULL si la file est vide.
+ * Complexité: O(1) en l'absence de contention
+ */
+extern void *mpmc_try_get(MpmcFifo *fifo);
+
+/* mpmc_put -- insère un nouvel élément dans la file, en attendant qu'une
+ * place se libère si elle est pleine.
+ * Complexité: O(1) en l'absence de contention
+ */
+extern void mpmc_put(MpmcFifo *fifo, void *item);
+
+/* mpmc_get -- retire un élément de la file, en attendant qu'il en arrive
+ * un si elle est vide, et renvoie un pointeur sur son contenu.
+ * Complexité: O(1) en l'absence de contention
+ */
+extern void *mpmc_get(MpmcFifo *fifo);
+
+#endif /* MPMC_H */
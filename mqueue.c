@@ -0,0 +1,210 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+
+#include "mqueue.h"
+
+/* Nombre d'essais avant de se rabattre sur une attente ou un parcours */
+#define MQUEUE_TRIES 8
+
+/* mqueue_random (fonction interne) -- renvoie un entier pseudo-aléatoire
+ * entre 0 et n-1. Chaque thread a son propre générateur (xorshift), ce
+ * qui évite tout partage entre threads.
+ * Complexité: O(1)
+ */
+static int mqueue_random(int n)
+{
+  static _Thread_local uint64_t state = 0;
+
+  if (state == 0)
+    state = ((uint64_t) (uintptr_t) &state * 0x9E3779B97F4A7C15ULL) | 1;
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return (int) ((state >> 32) % (uint64_t) n);
+}
+
+/* mqueue_new -- crée une file concurrente formée de nshards tas (au moins
+ * 2), ordonnée par la relation rel.
+ * Retourne un pointeur sur cette file, ou NULL si la création ne s'est
+ * pas bien passée.
+ * Complexité: O(nshards)
+ */
+MQueue *mqueue_new(int nshards, relation rel)
+{
+  MQueue *tmp;
+  int i;
+
+  assert((nshards >= 2) && (rel != NULL));
+  if ((tmp = (MQueue *) malloc(sizeof(MQueue))) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "mqueue_new: erreur d'allocation mémoire.\n");
+#endif
+    return NULL;
+  }
+  if (posix_memalign((void **) &tmp->shards, MQUEUE_CACHE_LINE,
+                     nshards*sizeof(MQueueShard)) != 0) {
+#ifdef DEBUG
+    fprintf(stderr, "mqueue_new: erreur d'allocation mémoire.\n");
+#endif
+    free(tmp);
+    return NULL;
+  }
+  /* Les tas sont rangés dans les shards meme (initialisés par heap_init
+   * au lieu d'etre alloués à part par heap_create): chaque tas partage
+   * ainsi la ligne de cache de son verrou, et aucune ligne n'est partagée
+   * entre deux shards.
+   */
+  for (i = 0; i < nshards; i++) {
+    if (!heap_init(&tmp->shards[i].heap, 16, rel)) {
+#ifdef DEBUG
+      fprintf(stderr, "mqueue_new: erreur d'allocation mémoire.\n");
+#endif
+      while (--i >= 0) {
+        heap_destroy(&tmp->shards[i].heap);
+        pthread_mutex_destroy(&tmp->shards[i].lock);
+      }
+      free(tmp->shards);
+      free(tmp);
+      return NULL;
+    }
+    pthread_mutex_init(&tmp->shards[i].lock, NULL);
+  }
+  tmp->nshards = nshards;
+  tmp->rel = rel;
+  atomic_init(&tmp->size, 0);
+  return tmp;
+}
+
+/* mqueue_free -- détruit une file et libère la mémoire qu'elle occupait.
+ * Aucun autre thread ne doit plus l'utiliser.
+ * Complexité: O(nshards)
+ */
+void mqueue_free(MQueue *q)
+{
+  int i;
+
+  assert((q != NULL) && (q->shards != NULL));
+  for (i = 0; i < q->nshards; i++) {
+    heap_destroy(&q->shards[i].heap);
+    pthread_mutex_destroy(&q->shards[i].lock);
+  }
+  free(q->shards);
+  free(q);
+}
+
+/* mqueue_size -- renvoie le nombre d'éléments de la file. En présence
+ * d'autres threads, la valeur peut etre périmée dès son retour.
+ * Complexité: O(1)
+ */
+int mqueue_size(MQueue *q)
+{
+  assert(q != NULL);
+  return atomic_load_explicit(&q->size, memory_order_relaxed);
+}
+
+/* mqueue_lock_random (fonction interne) -- verrouille un tas tiré au
+ * hasard et renvoie son indice. Les tas déjà verrouillés sont évités
+ * tant que possible; après MQUEUE_TRIES échecs, on attend le dernier
+ * tas tiré.
+ * Complexité: O(1) en moyenne
+ */
+static int mqueue_lock_random(MQueue *q)
+{
+  int i, tries;
+
+  for (tries = 0; tries < MQUEUE_TRIES; tries++) {
+    i = mqueue_random(q->nshards);
+    if (pthread_mutex_trylock(&q->shards[i].lock) == 0)
+      return i;
+  }
+  pthread_mutex_lock(&q->shards[i].lock);
+  return i;
+}
+
+/* mqueue_trylock_other (fonction interne) -- essaie de verrouiller un
+ * tas tiré au hasard, différent de except, et renvoie son indice, ou -1
+ * si tous les tas tirés étaient déjà verrouillés.
+ * On n'attend jamais ici, car l'appelant tient déjà le verrou de except.
+ * Complexité: O(1)
+ */
+static int mqueue_trylock_other(MQueue *q, int except)
+{
+  int i, tries;
+
+  for (tries = 0; tries < MQUEUE_TRIES; tries++) {
+    i = mqueue_random(q->nshards - 1);
+    if (i >= except) i += 1;
+    if (pthread_mutex_trylock(&q->shards[i].lock) == 0)
+      return i;
+  }
+  return -1;
+}
+
+/* mqueue_insert -- insère un élément dans un tas tiré au hasard.
+ * La valeur de retour indique si l'insertion s'est bien passée.
+ * Complexité: O(ln(mqueue_size(q)))
+ */
+int mqueue_insert(MQueue *q, void *item)
+{
+  int i, ok;
+
+  assert((q != NULL) && (item != NULL));
+  i = mqueue_lock_random(q);
+  /* Le compteur est mis à jour sous le verrou, de sorte qu'il ne puisse
+   * jamais passer sous zéro.
+   */
+  if ((ok = heap_insert(&q->shards[i].heap, item)))
+    atomic_fetch_add_explicit(&q->size, 1, memory_order_relaxed);
+  pthread_mutex_unlock(&q->shards[i].lock);
+  return ok;
+}
+
+/* mqueue_extract -- retire et renvoie un élément parmi les plus petits de
+ * la file (voir plus haut), ou NULL si la file est vide.
+ * Complexité: O(ln(mqueue_size(q))) en moyenne
+ */
+void *mqueue_extract(MQueue *q)
+{
+  Heap *best, *other;
+  void *item = NULL;
+  int i, j, tries;
+
+  assert(q != NULL);
+  for (tries = 0; tries < MQUEUE_TRIES; tries++) {
+    if (mqueue_size(q) == 0)
+      return NULL;
+    i = mqueue_lock_random(q);
+    j = mqueue_trylock_other(q, i);
+    /* Choisit la plus petite des deux racines */
+    best = &q->shards[i].heap;
+    if (j != -1) {
+      other = &q->shards[j].heap;
+      if ((heap_size(best) == 0) ||
+          ((heap_size(other) != 0) && q->rel(heap_root(best), heap_root(other))))
+        best = other;
+    }
+    if (heap_size(best) != 0) {
+      item = heap_extract_root(best);
+      atomic_fetch_sub_explicit(&q->size, 1, memory_order_relaxed);
+    }
+    if (j != -1) pthread_mutex_unlock(&q->shards[j].lock);
+    pthread_mutex_unlock(&q->shards[i].lock);
+    if (item != NULL)
+      return item;
+  }
+
+  /* La file est presque vide: plutot que de tirer des tas vides au
+   * hasard, on les parcourt tous.
+   */
+  for (i = 0; (i < q->nshards) && (item == NULL); i++) {
+    pthread_mutex_lock(&q->shards[i].lock);
+    if (heap_size(&q->shards[i].heap) != 0) {
+      item = heap_extract_root(&q->shards[i].heap);
+      atomic_fetch_sub_explicit(&q->size, 1, memory_order_relaxed);
+    }
+    pthread_mutex_unlock(&q->shards[i].lock);
+  }
+  return item;
+}
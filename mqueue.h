@@ -0,0 +1,72 @@
+#ifndef MQUEUE_H
+#define MQUEUE_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "heap.h"
+
+/* File de priorité concurrente relâchée (MultiQueue).
+ * La file est formée de plusieurs tas (Heap), chacun protégé par son
+ * propre verrou. Une insertion va dans un tas tiré au hasard; une
+ * extraction tire deux tas au hasard et retire la meilleure des deux
+ * racines. Les threads se partagent ainsi les verrous au lieu de se
+ * battre pour un seul, et le débit augmente avec le nombre de threads.
+ *
+ * En contrepartie, l'élément extrait n'est pas toujours le plus petit de
+ * la file. Avec n tas, le rang de l'élément extrait (son nombre de
+ * prédécesseurs dans la file) est O(n) en moyenne et O(n ln(n)) avec
+ * forte probabilité (Rihani, Sanders, Dementiev, "MultiQueues: Simple
+ * Relaxed Concurrent Priority Queues", 2015; Alistarh et al., "The Power
+ * of Choice in Priority Scheduling", 2017). On prend en général n égal à
+ * 2 à 4 fois le nombre de threads. Pour un thread donné, les éléments
+ * extraits d'un meme tas sortent dans l'ordre.
+ */
+
+#define MQUEUE_CACHE_LINE 64
+
+typedef struct {
+  _Alignas(MQUEUE_CACHE_LINE) pthread_mutex_t lock;
+  Heap heap;                    /* Le tas, à coté de son verrou */
+} MQueueShard;
+
+typedef struct {
+  int nshards;                  /* Nombre de tas */
+  relation rel;                 /* Relation d'ordre commune à tous les tas */
+  atomic_int size;              /* Nombre total d'éléments */
+  MQueueShard *shards;          /* Les tas et leurs verrous */
+} MQueue;
+
+/* mqueue_new -- crée une file concurrente formée de nshards tas (au moins
+ * 2), ordonnée par la relation rel.
+ * Retourne un pointeur sur cette file, ou NULL si la création ne s'est
+ * pas bien passée.
+ * Complexité: O(nshards)
+ */
+extern MQueue *mqueue_new(int nshards, relation rel);
+
+/* mqueue_free -- détruit une file et libère la mémoire qu'elle occupait.
+ * Aucun autre thread ne doit plus l'utiliser.
+ * Complexité: O(nshards)
+ */
+extern void mqueue_free(MQueue *q);
+
+/* mqueue_size -- renvoie le nombre d'éléments de la file. En présence
+ * d'autres threads, la valeur peut etre périmée dès son retour.
+ * Complexité: O(1)
+ */
+extern int mqueue_size(MQueue *q);
+
+/* mqueue_insert -- insère un élément dans un tas tiré au hasard.
+ * La valeur de retour indique si l'insertion s'est bien passée.
+ * Complexité: O(ln(mqueue_size(q)))
+ */
+extern int mqueue_insert(MQueue *q, void *item);
+
+/* mqueue_extract -- retire et renvoie un élément parmi les plus petits de
+ * la file (voir plus haut), ou NULL si la file est vide.
+ * Complexité: O(ln(mqueue_size(q))) en moyenne
+ */
+extern void *mqueue_extract(MQueue *q);
+
+#endif /* MQUEUE_H */
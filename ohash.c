@@ -0,0 +1,338 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "ohash.h"
+#include "hashfn.h"
+
+/* Valeurs particulières des octets de controle. Une case pleine contient
+ * 7 bits du code de hachage, donc une valeur positive.
+ */
+#define OHASH_EMPTY   ((signed char) -128)
+#define OHASH_DELETED ((signed char) -2)
+
+/* ohash_match (fonction interne) -- renvoie un masque dont le bit i est
+ * à 1 si l'octet de controle i du groupe g vaut c.
+ * Complexité: O(1)
+ */
+static unsigned int ohash_match(const signed char *g, signed char c)
+{
+#ifdef __SSE2__
+  __m128i ctrl = _mm_load_si128((const __m128i *) g);
+  return (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(c)));
+#else
+  unsigned int mask = 0;
+  int i;
+
+  for (i = 0; i < OHASH_GROUP; i++)
+    if (g[i] == c) mask |= 1U << i;
+  return mask;
+#endif
+}
+
+/* ohash_match_free (fonction interne) -- renvoie le masque des cases
+ * vides ou effacées du groupe g (les seules valeurs négatives).
+ * Complexité: O(1)
+ */
+static unsigned int ohash_match_free(const signed char *g)
+{
+#ifdef __SSE2__
+  return (unsigned int) _mm_movemask_epi8(_mm_load_si128((const __m128i *) g));
+#else
+  unsigned int mask = 0;
+  int i;
+
+  for (i = 0; i < OHASH_GROUP; i++)
+    if (g[i] < 0) mask |= 1U << i;
+  return mask;
+#endif
+}
+
+/* ohash_first_bit (fonction interne) -- renvoie l'indice du bit à 1 de
+ * poids le plus faible de mask (qui ne doit pas etre nul).
+ * Complexité: O(1)
+ */
+static int ohash_first_bit(unsigned int mask)
+{
+#ifdef __GNUC__
+  return __builtin_ctz(mask);
+#else
+  int i = 0;
+
+  while (!(mask & 1)) {
+    mask >>= 1;
+    i += 1;
+  }
+  return i;
+#endif
+}
+
+/* ohash_alloc (fonction interne) -- alloue et initialise les tableaux
+ * d'une table de max_size cases.
+ * La valeur de retour indique si l'allocation s'est bien passée.
+ * Complexité: O(max_size)
+ */
+static int ohash_alloc(OHashTable *table, int max_size)
+{
+  void *ctrl;
+
+  /* Les octets de controle sont alignés pour les chargements SSE2 */
+  if (posix_memalign(&ctrl, OHASH_GROUP, max_size) != 0)
+    return 0;
+  table->keys = (void **) malloc(max_size*sizeof(void *));
+  table->items = (void **) malloc(max_size*sizeof(void *));
+  if ((table->keys == NULL) || (table->items == NULL)) {
+    free(ctrl);
+    free(table->keys);
+    free(table->items);
+    return 0;
+  }
+  table->ctrl = (signed char *) ctrl;
+  memset(table->ctrl, OHASH_EMPTY, max_size);
+  table->max_size = max_size;
+  table->size = table->used = 0;
+  return 1;
+}
+
+/* ohash_table_new -- crée une table pouvant contenir au moins max_size
+ * clés avant de devoir s'agrandir.
+ * Retourne un pointeur sur cette table, ou NULL en cas d'échec.
+ * Complexité: O(max_size)
+ */
+OHashTable *ohash_table_new(int max_size, int (*h)(void *),
+                            int (*kequal)(void *, void *))
+{
+  OHashTable *tmp;
+  int size;
+
+  assert((max_size > 0) && (h != NULL) && (kequal != NULL));
+  /* On garde au moins 1/8 des cases vides */
+  for (size = OHASH_GROUP; size - size/8 < max_size; size *= 2)
+    ;
+  if ((tmp = (OHashTable *) malloc(sizeof(OHashTable))) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "ohash_table_new: erreur d'allocation mémoire.\n");
+#endif
+    return NULL;
+  }
+  if (!ohash_alloc(tmp, size)) {
+#ifdef DEBUG
+    fprintf(stderr, "ohash_table_new: erreur d'allocation mémoire.\n");
+#endif
+    free(tmp);
+    return NULL;
+  }
+  tmp->h = h;
+  tmp->kequal = kequal;
+  return tmp;
+}
+
+/* ohash_table_free -- détruit une table et libère la mémoire qu'elle
+ * occupait (mais pas celle des clés et des données).
+ * Complexité: O(1)
+ */
+void ohash_table_free(OHashTable *table)
+{
+  assert(table != NULL);
+  free(table->ctrl);
+  free(table->keys);
+  free(table->items);
+  free(table);
+}
+
+/* ohash_lookup (fonction interne) -- cherche key dans la table, dont le
+ * code de hachage mélangé est hash.
+ * Renvoie l'indice de la case de key, ou -1 si elle est absente. Dans ce
+ * dernier cas, si free_slot n'est pas NULL, on y range l'indice de la
+ * première case libre (vide ou effacée) rencontrée.
+ * Les groupes sont parcourus selon une suite triangulaire (g, g+1, g+3,
+ * g+6...) qui passe par tous les groupes; on s'arrete au premier groupe
+ * qui a une case vide, puisqu'une insertion ne serait pas allée plus loin.
+ * Complexité: O(1) en moyenne
+ */
+static int ohash_lookup(OHashTable *table, void *key, unsigned int hash,
+                        int *free_slot)
+{
+  unsigned int groups_mask = table->max_size/OHASH_GROUP - 1;
+  unsigned int g = (hash >> 7) & groups_mask;
+  signed char h2 = (signed char) (hash & 0x7F);
+  const signed char *ctrl;
+  unsigned int mask;
+  int probe, slot;
+
+  if (free_slot != NULL) *free_slot = -1;
+  for (probe = 1; ; probe++) {
+    ctrl = table->ctrl + g*OHASH_GROUP;
+    for (mask = ohash_match(ctrl, h2); mask != 0; mask &= mask - 1) {
+      slot = g*OHASH_GROUP + ohash_first_bit(mask);
+      if (table->kequal(table->keys[slot], key))
+        return slot;
+    }
+    if ((free_slot != NULL) && (*free_slot == -1) &&
+        ((mask = ohash_match_free(ctrl)) != 0))
+      *free_slot = g*OHASH_GROUP + ohash_first_bit(mask);
+    if (ohash_match(ctrl, OHASH_EMPTY) != 0)
+      return -1;
+    g = (g + probe) & groups_mask;
+  }
+}
+
+/* ohash_resize (fonction interne) -- reconstruit la table avec max_size
+ * cases, ce qui fait aussi disparaitre les cases effacées.
+ * La valeur de retour indique si l'opération s'est bien passée (en cas
+ * d'échec, la table est inchangée).
+ * Complexité: O(max_size)
+ */
+static int ohash_resize(OHashTable *table, int max_size)
+{
+  OHashTable old = *table;
+  unsigned int hash;
+  int i, slot;
+
+  if (!ohash_alloc(table, max_size)) {
+    *table = old;
+    return 0;
+  }
+  for (i = 0; i < old.max_size; i++)
+    if (old.ctrl[i] >= 0) {
+      hash = hash_mix32((uint32_t) table->h(old.keys[i]));
+      ohash_lookup(table, old.keys[i], hash, &slot);
+      table->ctrl[slot] = (signed char) (hash & 0x7F);
+      table->keys[slot] = old.keys[i];
+      table->items[slot] = old.items[i];
+      table->size += 1;
+      table->used += 1;
+    }
+  free(old.ctrl);
+  free(old.keys);
+  free(old.items);
+  return 1;
+}
+
+/* ohash_table_insert -- associe item à key. La table s'agrandit si
+ * nécessaire.
+ * La valeur de retour indique si l'insertion s'est faite (0 si key
+ * était déjà présente ou en cas d'erreur d'allocation mémoire).
+ * Complexité: O(1) en moyenne
+ */
+int ohash_table_insert(OHashTable *table, void *key, void *item)
+{
+  unsigned int hash;
+  int slot;
+
+  assert((table != NULL) && (item != NULL));
+  hash = hash_mix32((uint32_t) table->h(key));
+  if (ohash_lookup(table, key, hash, &slot) != -1)
+    return 0;
+  if ((table->ctrl[slot] == OHASH_EMPTY) &&
+      (table->used + 1 > table->max_size - table->max_size/8)) {
+    /* Trop peu de cases vides: on double la taille, ou on se contente de
+     * nettoyer les cases effacées si elles sont nombreuses.
+     */
+    if (!ohash_resize(table, (table->size + 1 > table->max_size/2) ?
+                      2*table->max_size : table->max_size))
+      return 0;
+    ohash_lookup(table, key, hash, &slot);
+  }
+  if (table->ctrl[slot] == OHASH_EMPTY)
+    table->used += 1;
+  table->ctrl[slot] = (signed char) (hash & 0x7F);
+  table->keys[slot] = key;
+  table->items[slot] = item;
+  table->size += 1;
+  return 1;
+}
+
+/* ohash_table_remove -- retire key de la table.
+ * La valeur de retour indique si key était présente.
+ * Complexité: O(1) en moyenne
+ */
+int ohash_table_remove(OHashTable *table, void *key)
+{
+  int slot;
+
+  assert(table != NULL);
+  slot = ohash_lookup(table, key, hash_mix32((uint32_t) table->h(key)), NULL);
+  if (slot == -1)
+    return 0;
+  /* Si le groupe a encore une case vide, aucune recherche n'est passée
+   * au delà: la case peut redevenir vide. Sinon, elle est marquée
+   * effacée pour ne pas interrompre les recherches qui la traversent.
+   */
+  if (ohash_match(table->ctrl + (slot & ~(OHASH_GROUP - 1)), OHASH_EMPTY) != 0) {
+    table->ctrl[slot] = OHASH_EMPTY;
+    table->used -= 1;
+  } else
+    table->ctrl[slot] = OHASH_DELETED;
+  table->size -= 1;
+  return 1;
+}
+
+/* ohash_table_find -- renvoie la donnée associée à key, ou NULL si key
+ * n'est pas dans la table.
+ * Complexité: O(1) en moyenne
+ */
+void *ohash_table_find(OHashTable *table, void *key)
+{
+  int slot;
+
+  assert(table != NULL);
+  slot = ohash_lookup(table, key, hash_mix32((uint32_t) table->h(key)), NULL);
+  return (slot == -1) ? NULL : table->items[slot];
+}
+
+/* ohash_table_max_size -- renvoie le nombre de cases de la table.
+ * Complexité: O(1)
+ */
+int ohash_table_max_size(OHashTable *table)
+{
+  return (table == NULL) ? 0 : table->max_size;
+}
+
+/* ohash_table_size -- renvoie le nombre de clés de la table.
+ * Complexité: O(1)
+ */
+int ohash_table_size(OHashTable *table)
+{
+  return (table == NULL) ? 0 : table->size;
+}
+
+/* ohash_table_empty -- détermine si la table est vide.
+ * Complexité: O(1)
+ */
+int ohash_table_empty(OHashTable *table)
+{
+  return (ohash_table_size(table) == 0);
+}
+
+/* ohash_table_stats -- mesure la qualité de la fonction de hachage:
+ * range dans histogram[i] le nombre de clés trouvées après avoir examiné
+ * i+1 groupes (i = 0: la clé est dans son groupe d'origine), pour i de 0
+ * à nbins-2; histogram[nbins-1] compte les clés plus éloignées.
+ * Renvoie le plus grand nombre de groupes examinés pour trouver une clé.
+ * Complexité: O(ohash_table_max_size(table)) en moyenne
+ */
+int ohash_table_stats(OHashTable *table, int *histogram, int nbins)
+{
+  unsigned int groups_mask, g;
+  int i, probe, max = 0;
+
+  assert((table != NULL) && (histogram != NULL) && (nbins > 0));
+  for (i = 0; i < nbins; i++)
+    histogram[i] = 0;
+  groups_mask = table->max_size/OHASH_GROUP - 1;
+  for (i = 0; i < table->max_size; i++)
+    if (table->ctrl[i] >= 0) {
+      /* Refait la suite de groupes de ohash_lookup jusqu'à celui de i */
+      g = (hash_mix32((uint32_t) table->h(table->keys[i])) >> 7) & groups_mask;
+      for (probe = 1; g != (unsigned int) i/OHASH_GROUP; probe++)
+        g = (g + probe) & groups_mask;
+      histogram[(probe - 1 < nbins - 1) ? probe - 1 : nbins - 1] += 1;
+      if (probe > max) max = probe;
+    }
+  return max;
+}
@@ -0,0 +1,89 @@
+#ifndef OHASH_H
+#define OHASH_H
+
+/* Table de hachage à adressage ouvert, dans le style des "Swiss tables".
+ * Les clés et les données sont rangées directement dans deux tableaux
+ * plats; un troisième tableau d'octets de controle indique pour chaque
+ * case si elle est vide, effacée, ou pleine, et dans ce dernier cas
+ * garde 7 bits du code de hachage de la clé. Les cases sont examinées par
+ * groupes de OHASH_GROUP: un seul test vectoriel (SSE2) sur les octets de
+ * controle d'un groupe donne les cases candidates, et la fonction kequal
+ * n'est appelée que sur celles-ci.
+ * Le code renvoyé par h est mélangé par hash_mix32 (voir hashfn.h).
+ * Comme pour HashTable, h convertit une clé en entier et kequal compare
+ * deux clés. Les clés peuvent etre quelconques (y compris NULL), mais
+ * les données ne doivent pas etre NULL.
+ */
+
+#define OHASH_GROUP 16          /* Nombre de cases examinées à la fois */
+
+typedef struct {
+  int max_size;                 /* Nombre de cases (puissance de 2) */
+  int size;                     /* Nombre de clés présentes */
+  int used;                     /* Nombre de cases pleines ou effacées */
+  int (*h)(void *);             /* Convertit une clé en entier */
+  int (*kequal)(void *, void *); /* Prédicat de comparaison de clés */
+  signed char *ctrl;            /* Octets de controle */
+  void **keys;                  /* Les clés */
+  void **items;                 /* Les données */
+} OHashTable;
+
+/* ohash_table_new -- crée une table pouvant contenir au moins max_size
+ * clés avant de devoir s'agrandir.
+ * Retourne un pointeur sur cette table, ou NULL en cas d'échec.
+ * Complexité: O(max_size)
+ */
+extern OHashTable *ohash_table_new(int max_size, int (*h)(void *),
+                                   int (*kequal)(void *, void *));
+
+/* ohash_table_free -- détruit une table et libère la mémoire qu'elle
+ * occupait (mais pas celle des clés et des données).
+ * Complexité: O(1)
+ */
+extern void ohash_table_free(OHashTable *table);
+
+/* ohash_table_insert -- associe item à key. La table s'agrandit si
+ * nécessaire.
+ * La valeur de retour indique si l'insertion s'est faite (0 si key
+ * était déjà présente ou en cas d'erreur d'allocation mémoire).
+ * Complexité: O(1) en moyenne
+ */
+extern int ohash_table_insert(OHashTable *table, void *key, void *item);
+
+/* ohash_table_remove -- retire key de la table.
+ * La valeur de retour indique si key était présente.
+ * Complexité: O(1) en moyenne
+ */
+extern int ohash_table_remove(OHashTable *table, void *key);
+
+/* ohash_table_find -- renvoie la donnée associée à key, ou NULL si key
+ * n'est pas dans la table.
+ * Complexité: O(1) en moyenne
+ */
+extern void *ohash_table_find(OHashTable *table, void *key);
+
+/* ohash_table_max_size -- renvoie le nombre de cases de la table.
+ * Complexité: O(1)
+ */
+extern int ohash_table_max_size(OHashTable *table);
+
+/* ohash_table_size -- renvoie le nombre de clés de la table.
+ * Complexité: O(1)
+ */
+extern int ohash_table_size(OHashTable *table);
+
+/* ohash_table_empty -- détermine si la table est vide.
+ * Complexité: O(1)
+ */
+extern int ohash_table_empty(OHashTable *table);
+
+/* ohash_table_stats -- mesure la qualité de la fonction de hachage:
+ * range dans histogram[i] le nombre de clés trouvées après avoir examiné
+ * i+1 groupes (i = 0: la clé est dans son groupe d'origine), pour i de 0
+ * à nbins-2; histogram[nbins-1] compte les clés plus éloignées.
+ * Renvoie le plus grand nombre de groupes examinés pour trouver une clé.
+ * Complexité: O(ohash_table_max_size(table)) en moyenne
+ */
+extern int ohash_table_stats(OHashTable *table, int *histogram, int nbins);
+
+#endif /* OHASH_H */
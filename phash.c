@@ -0,0 +1,405 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "phash.h"
+#include "hashfn.h"
+
+#define PHASH_MAGIC "PHASH01"
+#define PHASH_PAGE 4096
+
+/* Accès à l'en-tete, et conversion d'une position en adresse. Une adresse
+ * n'est valable que jusqu'au prochain agrandissement du fichier.
+ */
+#define phash_header(t) ((PHashHeader *) (t)->base)
+#define phash_at(t, off) ((t)->base + (off))
+#define phash_align(n) (((n) + 7) & ~(uint64_t) 7)
+
+/* Position de la donnée d'une entrée, par rapport à l'entrée: la donnée
+ * suit la clé, alignée sur 8 octets.
+ */
+#define phash_item_offset(key_len) phash_align(sizeof(PHashEntry) + (key_len))
+
+/* phash_map (fonction interne) -- projette les size premiers octets du
+ * fichier de la table selon son mode, sans défaire la projection
+ * courante.
+ * La valeur de retour indique si la projection s'est bien passée (en cas
+ * d'échec, la table est inchangée).
+ * Complexité: O(1)
+ */
+static int phash_map(PHashTable *table, size_t size)
+{
+  void *base;
+
+  if (table->mode == PHASH_RDONLY)
+    base = mmap(NULL, size, PROT_READ, MAP_SHARED, table->fd, 0);
+  else
+    base = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                (table->mode == PHASH_RDWR) ? MAP_SHARED : MAP_PRIVATE, table->fd, 0);
+  if (base == MAP_FAILED)
+    return 0;
+  table->base = (char *) base;
+  table->map_size = size;
+  return 1;
+}
+
+/* phash_reserve (fonction interne) -- s'assure qu'il reste au moins n
+ * octets libres après la zone utilisée, en doublant la taille du fichier
+ * si nécessaire. En mode PHASH_PRIVATE, le fichier n'est jamais modifié:
+ * la table est recopiée dans une zone anonyme plus grande.
+ * La valeur de retour indique si l'opération s'est bien passée (en cas
+ * d'échec, la table est inchangée).
+ * Complexité: O(1) amortie
+ */
+static int phash_reserve(PHashTable *table, uint64_t n)
+{
+  PHashHeader *hd = phash_header(table);
+  uint64_t size = hd->file_size;
+  size_t old_size = table->map_size;
+  char *old_base = table->base;
+  void *base;
+
+  if (hd->used + n <= hd->file_size)
+    return 1;
+  while (size < hd->used + n)
+    size *= 2;
+  if (table->mode == PHASH_RDWR) {
+    /* La nouvelle projection est faite avant de défaire l'ancienne: en
+     * cas d'échec, on garde l'ancienne et on rend au fichier sa taille.
+     */
+    if (ftruncate(table->fd, (off_t) size) != 0) {
+#ifdef DEBUG
+      fprintf(stderr, "phash_reserve: impossible d'agrandir le fichier.\n");
+#endif
+      return 0;
+    }
+    if (!phash_map(table, size)) {
+#ifdef DEBUG
+      fprintf(stderr, "phash_reserve: impossible de projeter le fichier.\n");
+#endif
+      if (ftruncate(table->fd, (off_t) old_size) != 0) {
+#ifdef DEBUG
+        fprintf(stderr, "phash_reserve: impossible de réduire le fichier.\n");
+#endif
+      }
+      return 0;
+    }
+    munmap(old_base, old_size);
+  } else {
+    base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+#ifdef DEBUG
+      fprintf(stderr, "phash_reserve: erreur d'allocation mémoire.\n");
+#endif
+      return 0;
+    }
+    memcpy(base, table->base, hd->used);
+    munmap(table->base, table->map_size);
+    table->base = (char *) base;
+    table->map_size = size;
+  }
+  phash_header(table)->file_size = size;
+  return 1;
+}
+
+/* phash_alloc (fonction interne) -- réserve n octets (mis à zéro) à la
+ * fin de la zone utilisée et renvoie leur position, ou 0 en cas d'échec.
+ * Complexité: O(n) amortie
+ */
+static uint64_t phash_alloc(PHashTable *table, uint64_t n)
+{
+  uint64_t off;
+
+  n = phash_align(n);
+  if (!phash_reserve(table, n))
+    return 0;
+  off = phash_header(table)->used;
+  memset(phash_at(table, off), 0, n);
+  phash_header(table)->used += n;
+  return off;
+}
+
+/* phash_create -- crée (ou écrase) le fichier path et y construit une
+ * table vide prévue pour max_size clés, ouverte en mode PHASH_RDWR.
+ * Retourne un pointeur sur cette table, ou NULL en cas d'échec.
+ * Complexité: O(max_size)
+ */
+PHashTable *phash_create(const char *path, int max_size)
+{
+  PHashTable *tmp;
+  PHashHeader *hd;
+  uint64_t size, buckets;
+  uint32_t n;
+
+  assert((path != NULL) && (max_size > 0));
+  for (n = 16; n < (uint32_t) max_size; n *= 2)
+    ;
+  /* En-tete, paniers, et de la place pour une soixantaine d'octets par
+   * clé.
+   */
+  buckets = phash_align(sizeof(PHashHeader));
+  size = buckets + n*sizeof(uint64_t) + 64*(uint64_t) max_size;
+  size = (size + PHASH_PAGE - 1) & ~(uint64_t) (PHASH_PAGE - 1);
+  if ((tmp = (PHashTable *) malloc(sizeof(PHashTable))) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "phash_create: erreur d'allocation mémoire.\n");
+#endif
+    return NULL;
+  }
+  tmp->mode = PHASH_RDWR;
+  if ((tmp->fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644)) < 0) {
+#ifdef DEBUG
+    fprintf(stderr, "phash_create: impossible de créer %s.\n", path);
+#endif
+    free(tmp);
+    return NULL;
+  }
+  if ((ftruncate(tmp->fd, (off_t) size) != 0) || !phash_map(tmp, size)) {
+#ifdef DEBUG
+    fprintf(stderr, "phash_create: impossible de projeter %s.\n", path);
+#endif
+    close(tmp->fd);
+    free(tmp);
+    return NULL;
+  }
+  /* Le fichier vient d'etre créé: il ne contient que des zéros */
+  hd = phash_header(tmp);
+  memcpy(hd->magic, PHASH_MAGIC, sizeof(hd->magic));
+  hd->file_size = size;
+  hd->buckets = buckets;
+  hd->nbuckets = n;
+  hd->used = buckets + n*sizeof(uint64_t);
+  hd->size = 0;
+  return tmp;
+}
+
+/* phash_open -- ouvre une table existante dans le mode mode.
+ * Retourne un pointeur sur cette table, ou NULL en cas d'échec (fichier
+ * absent ou qui n'est pas une table).
+ * Complexité: O(1)
+ */
+PHashTable *phash_open(const char *path, int mode)
+{
+  PHashTable *tmp;
+  PHashHeader *hd;
+  struct stat st;
+
+  assert((path != NULL) &&
+         ((mode == PHASH_RDWR) || (mode == PHASH_RDONLY) || (mode == PHASH_PRIVATE)));
+  if ((tmp = (PHashTable *) malloc(sizeof(PHashTable))) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "phash_open: erreur d'allocation mémoire.\n");
+#endif
+    return NULL;
+  }
+  tmp->mode = mode;
+  if ((tmp->fd = open(path, (mode == PHASH_RDWR) ? O_RDWR : O_RDONLY)) < 0) {
+    free(tmp);
+    return NULL;
+  }
+  if ((fstat(tmp->fd, &st) != 0) || (st.st_size < (off_t) sizeof(PHashHeader)) ||
+      !phash_map(tmp, (size_t) st.st_size)) {
+    close(tmp->fd);
+    free(tmp);
+    return NULL;
+  }
+  /* Vérifie que le fichier ressemble bien à une table */
+  hd = phash_header(tmp);
+  if ((memcmp(hd->magic, PHASH_MAGIC, sizeof(hd->magic)) != 0) ||
+      (hd->file_size != (uint64_t) st.st_size) || (hd->used > hd->file_size) ||
+      (hd->nbuckets == 0) || ((hd->nbuckets & (hd->nbuckets - 1)) != 0) ||
+      (hd->buckets + hd->nbuckets*sizeof(uint64_t) > hd->used)) {
+#ifdef DEBUG
+    fprintf(stderr, "phash_open: %s n'est pas une table.\n", path);
+#endif
+    munmap(tmp->base, tmp->map_size);
+    close(tmp->fd);
+    free(tmp);
+    return NULL;
+  }
+  return tmp;
+}
+
+/* phash_sync -- force l'écriture des modifications dans le fichier (mode
+ * PHASH_RDWR seulement).
+ * La valeur de retour indique si l'écriture s'est bien passée.
+ * Complexité: O(taille des modifications)
+ */
+int phash_sync(PHashTable *table)
+{
+  assert(table != NULL);
+  if (table->mode != PHASH_RDWR)
+    return 0;
+  return msync(table->base, table->map_size, MS_SYNC) == 0;
+}
+
+/* phash_close -- ferme une table. En mode PHASH_RDWR, les modifications
+ * sont écrites dans le fichier.
+ * La valeur de retour indique si tout s'est bien passé.
+ * Complexité: O(taille des modifications)
+ */
+int phash_close(PHashTable *table)
+{
+  int ok = 1;
+
+  assert(table != NULL);
+  if (table->mode == PHASH_RDWR)
+    ok = phash_sync(table);
+  if (munmap(table->base, table->map_size) != 0) ok = 0;
+  if (close(table->fd) != 0) ok = 0;
+  free(table);
+  return ok;
+}
+
+/* phash_lookup (fonction interne) -- cherche la clé key, de code hash.
+ * Renvoie l'adresse du lien (case du tableau de paniers ou champ next)
+ * qui désigne son entrée, ou NULL si elle est absente.
+ * Complexité: O(1) en moyenne
+ */
+static uint64_t *phash_lookup(PHashTable *table, const void *key, size_t key_len,
+                              uint64_t hash)
+{
+  PHashHeader *hd = phash_header(table);
+  uint64_t *link;
+  PHashEntry *e;
+
+  link = (uint64_t *) phash_at(table, hd->buckets) + (hash & (hd->nbuckets - 1));
+  for (; *link != 0; link = &e->next) {
+    e = (PHashEntry *) phash_at(table, *link);
+    if ((e->hash == hash) && (e->key_len == key_len) &&
+        (memcmp(e + 1, key, key_len) == 0))
+      return link;
+  }
+  return NULL;
+}
+
+/* phash_grow (fonction interne) -- double le nombre de paniers. Le
+ * nouveau tableau est alloué à la fin du fichier (l'ancien est perdu) et
+ * les entrées y sont rechainées, sans recalculer les codes de hachage.
+ * Si la place manque, la table garde simplement ses paniers.
+ * Complexité: O(phash_size(table))
+ */
+static void phash_grow(PHashTable *table)
+{
+  PHashHeader *hd;
+  uint64_t *old, *buckets;
+  uint64_t off, e, next;
+  uint32_t i, n;
+
+  n = 2*phash_header(table)->nbuckets;
+  if ((off = phash_alloc(table, n*sizeof(uint64_t))) == 0)
+    return;
+  hd = phash_header(table);
+  old = (uint64_t *) phash_at(table, hd->buckets);
+  buckets = (uint64_t *) phash_at(table, off);
+  for (i = 0; i < hd->nbuckets; i++)
+    for (e = old[i]; e != 0; e = next) {
+      next = ((PHashEntry *) phash_at(table, e))->next;
+      ((PHashEntry *) phash_at(table, e))->next =
+        buckets[((PHashEntry *) phash_at(table, e))->hash & (n - 1)];
+      buckets[((PHashEntry *) phash_at(table, e))->hash & (n - 1)] = e;
+    }
+  hd->buckets = off;
+  hd->nbuckets = n;
+}
+
+/* phash_insert -- associe à la clé key (de key_len octets) une copie
+ * de la donnée item (de item_len octets).
+ * La valeur de retour indique si l'insertion s'est faite (0 si la clé
+ * est déjà présente, si la table est en lecture seule ou en cas
+ * d'erreur). Les pointeurs renvoyés auparavant par phash_find peuvent
+ * ne plus etre valides si le fichier a du etre agrandi.
+ * Complexité: O(1) en moyenne
+ */
+int phash_insert(PHashTable *table, const void *key, size_t key_len,
+                 const void *item, size_t item_len)
+{
+  PHashHeader *hd;
+  PHashEntry *e;
+  uint64_t hash, off, *bucket;
+
+  assert((table != NULL) && ((key != NULL) || (key_len == 0)) &&
+         ((item != NULL) || (item_len == 0)));
+  if ((table->mode == PHASH_RDONLY) || (key_len > UINT32_MAX) || (item_len > UINT32_MAX))
+    return 0;
+  hash = hash_bytes(key, key_len, 0);
+  if (phash_lookup(table, key, key_len, hash) != NULL)
+    return 0;
+  if (phash_header(table)->size >= phash_header(table)->nbuckets)
+    phash_grow(table);
+  if ((off = phash_alloc(table, phash_item_offset(key_len) + item_len)) == 0)
+    return 0;
+  /* Les adresses ne sont calculées qu'après l'éventuel agrandissement */
+  hd = phash_header(table);
+  e = (PHashEntry *) phash_at(table, off);
+  e->hash = hash;
+  e->key_len = (uint32_t) key_len;
+  e->item_len = (uint32_t) item_len;
+  memcpy(e + 1, key, key_len);
+  memcpy((char *) e + phash_item_offset(key_len), item, item_len);
+  bucket = (uint64_t *) phash_at(table, hd->buckets) + (hash & (hd->nbuckets - 1));
+  e->next = *bucket;
+  *bucket = off;
+  hd->size += 1;
+  return 1;
+}
+
+/* phash_remove -- retire la clé key (de key_len octets).
+ * La valeur de retour indique si la clé était présente (0 aussi si la
+ * table est en lecture seule).
+ * Complexité: O(1) en moyenne
+ */
+int phash_remove(PHashTable *table, const void *key, size_t key_len)
+{
+  uint64_t *link;
+
+  assert((table != NULL) && ((key != NULL) || (key_len == 0)));
+  if (table->mode == PHASH_RDONLY)
+    return 0;
+  if ((link = phash_lookup(table, key, key_len, hash_bytes(key, key_len, 0))) == NULL)
+    return 0;
+  *link = ((PHashEntry *) phash_at(table, *link))->next;
+  phash_header(table)->size -= 1;
+  return 1;
+}
+
+/* phash_find -- renvoie un pointeur sur la donnée associée à la clé key
+ * (de key_len octets), directement dans le fichier projeté, ou NULL si
+ * la clé est absente. Si item_len n'est pas NULL, on y range la longueur
+ * de la donnée. La donnée est alignée sur 8 octets.
+ * Complexité: O(1) en moyenne
+ */
+const void *phash_find(PHashTable *table, const void *key, size_t key_len,
+                       size_t *item_len)
+{
+  uint64_t *link;
+  PHashEntry *e;
+
+  assert((table != NULL) && ((key != NULL) || (key_len == 0)));
+  if ((link = phash_lookup(table, key, key_len, hash_bytes(key, key_len, 0))) == NULL)
+    return NULL;
+  e = (PHashEntry *) phash_at(table, *link);
+  if (item_len != NULL) *item_len = e->item_len;
+  return (char *) e + phash_item_offset(e->key_len);
+}
+
+/* phash_size -- renvoie le nombre de clés de la table.
+ * Complexité: O(1)
+ */
+int phash_size(PHashTable *table)
+{
+  return (table == NULL) ? 0 : (int) phash_header(table)->size;
+}
+
+/* phash_max_size -- renvoie le nombre de paniers de la table.
+ * Complexité: O(1)
+ */
+int phash_max_size(PHashTable *table)
+{
+  return (table == NULL) ? 0 : (int) phash_header(table)->nbuckets;
+}
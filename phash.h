@@ -0,0 +1,124 @@
+#ifndef PHASH_H
+#define PHASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Table de hachage persistante, rangée dans un fichier projeté en
+ * mémoire (mmap).
+ * Le fichier contient tout: en-tete, tableau de paniers et entrées. Les
+ * liens sont des positions dans le fichier (0 désignant "aucun") et non
+ * des pointeurs, si bien qu'une table construite une fois peut etre
+ * rouverte instantanément par n'importe quel processus, sans rien
+ * reconstruire: seules les pages lues sont chargées, et elles sont
+ * partagées entre processus par le cache du système.
+ *
+ * Les clés et les données sont des suites d'octets de longueur
+ * quelconque, recopiées dans le fichier à la suite de leur entrée. La
+ * place est allouée en ajoutant à la fin de la zone utilisée; le fichier
+ * double de taille quand il est plein, et une entrée retirée n'est pas
+ * récupérée.
+ *
+ * Une table s'ouvre de trois façons:
+ * - PHASH_RDWR: les modifications sont écrites dans le fichier;
+ * - PHASH_RDONLY: lecture seule, les insertions et suppressions échouent;
+ * - PHASH_PRIVATE: copie sur écriture, les modifications restent propres
+ *   au processus et ne vont jamais dans le fichier.
+ * Un seul processus à la fois doit modifier un fichier.
+ * Le format dépend de l'architecture (ordre des octets).
+ */
+
+#define PHASH_RDWR    0
+#define PHASH_RDONLY  1
+#define PHASH_PRIVATE 2
+
+typedef struct {
+  char magic[8];                /* "PHASH01" */
+  uint64_t file_size;           /* Taille de la zone projetée */
+  uint64_t used;                /* Fin de la zone allouée */
+  uint64_t buckets;             /* Position du tableau de paniers */
+  uint32_t nbuckets;            /* Nombre de paniers (puissance de 2) */
+  uint32_t size;                /* Nombre de clés */
+} PHashHeader;
+
+typedef struct {
+  uint64_t next;                /* Position de l'entrée suivante du panier */
+  uint64_t hash;                /* Code de hachage de la clé */
+  uint32_t key_len;             /* Longueur de la clé (en octets) */
+  uint32_t item_len;            /* Longueur de la donnée (en octets) */
+  /* Suivis de la clé puis de la donnée */
+} PHashEntry;
+
+typedef struct {
+  int fd;                       /* Descripteur du fichier */
+  int mode;                     /* PHASH_RDWR, PHASH_RDONLY ou PHASH_PRIVATE */
+  size_t map_size;              /* Taille de la projection */
+  char *base;                   /* Début de la projection (l'en-tete) */
+} PHashTable;
+
+/* phash_create -- crée (ou écrase) le fichier path et y construit une
+ * table vide prévue pour max_size clés, ouverte en mode PHASH_RDWR.
+ * Retourne un pointeur sur cette table, ou NULL en cas d'échec.
+ * Complexité: O(max_size)
+ */
+extern PHashTable *phash_create(const char *path, int max_size);
+
+/* phash_open -- ouvre une table existante dans le mode mode.
+ * Retourne un pointeur sur cette table, ou NULL en cas d'échec (fichier
+ * absent ou qui n'est pas une table).
+ * Complexité: O(1)
+ */
+extern PHashTable *phash_open(const char *path, int mode);
+
+/* phash_close -- ferme une table. En mode PHASH_RDWR, les modifications
+ * sont écrites dans le fichier.
+ * La valeur de retour indique si tout s'est bien passé.
+ * Complexité: O(taille des modifications)
+ */
+extern int phash_close(PHashTable *table);
+
+/* phash_sync -- force l'écriture des modifications dans le fichier (mode
+ * PHASH_RDWR seulement).
+ * La valeur de retour indique si l'écriture s'est bien passée.
+ * Complexité: O(taille des modifications)
+ */
+extern int phash_sync(PHashTable *table);
+
+/* phash_insert -- associe à la clé key (de key_len octets) une copie
+ * de la donnée item (de item_len octets).
+ * La valeur de retour indique si l'insertion s'est faite (0 si la clé
+ * est déjà présente, si la table est en lecture seule ou en cas
+ * d'erreur). Les pointeurs renvoyés auparavant par phash_find peuvent
+ * ne plus etre valides si le fichier a du etre agrandi.
+ * Complexité: O(1) en moyenne
+ */
+extern int phash_insert(PHashTable *table, const void *key, size_t key_len,
+                        const void *item, size_t item_len);
+
+/* phash_remove -- retire la clé key (de key_len octets).
+ * La valeur de retour indique si la clé était présente (0 aussi si la
+ * table est en lecture seule).
+ * Complexité: O(1) en moyenne
+ */
+extern int phash_remove(PHashTable *table, const void *key, size_t key_len);
+
+/* phash_find -- renvoie un pointeur sur la donnée associée à la clé key
+ * (de key_len octets), directement dans le fichier projeté, ou NULL si
+ * la clé est absente. Si item_len n'est pas NULL, on y range la longueur
+ * de la donnée. La donnée est alignée sur 8 octets.
+ * Complexité: O(1) en moyenne
+ */
+extern const void *phash_find(PHashTable *table, const void *key, size_t key_len,
+                              size_t *item_len);
+
+/* phash_size -- renvoie le nombre de clés de la table.
+ * Complexité: O(1)
+ */
+extern int phash_size(PHashTable *table);
+
+/* phash_max_size -- renvoie le nombre de paniers de la table.
+ * Complexité: O(1)
+ */
+extern int phash_max_size(PHashTable *table);
+
+#endif /* PHASH_H */
@@ -0,0 +1,133 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "pool.h"
+
+/* Les objets d'un slab commencent juste après son en-tete */
+#define pool_slab_item(pool, slab, i) \
+  ((char *) ((slab) + 1) + (size_t) (i) * (pool)->item_size)
+
+/* pool_new -- crée une réserve d'objets de item_size octets, découpés
+ * par slabs de slab_items objets. Aucun slab n'est alloué tout de suite.
+ * Retourne un pointeur sur cette réserve, ou NULL en cas d'échec.
+ * Complexité: O(1)
+ */
+Pool *pool_new(size_t item_size, int slab_items)
+{
+  Pool *tmp;
+
+  assert((item_size > 0) && (slab_items > 0));
+  if ((tmp = (Pool *) malloc(sizeof(Pool))) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "pool_new: erreur d'allocation mémoire.\n");
+#endif
+    return NULL;
+  }
+  /* Un objet libre doit pouvoir contenir le chainage de la liste libre */
+  if (item_size < sizeof(void *))
+    item_size = sizeof(void *);
+  tmp->item_size = (item_size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+  tmp->slab_items = slab_items;
+  tmp->size = 0;
+  tmp->nslabs = 0;
+  tmp->slabs = tmp->current = NULL;
+  tmp->next = 0;
+  tmp->free_list = NULL;
+  return tmp;
+}
+
+/* pool_free -- détruit une réserve et libère la mémoire qu'elle occupait,
+ * y compris celle des objets qui n'ont pas été rendus.
+ * Complexité: O(nombre de slabs)
+ */
+void pool_free(Pool *pool)
+{
+  PoolSlab *s, *next;
+
+  assert(pool != NULL);
+  for (s = pool->slabs; s != NULL; s = next) {
+    next = s->next;
+    free(s);
+  }
+  free(pool);
+}
+
+/* pool_alloc -- renvoie un objet (non initialisé) de la réserve, ou NULL
+ * en cas d'erreur d'allocation mémoire.
+ * Complexité: O(1)
+ */
+void *pool_alloc(Pool *pool)
+{
+  PoolSlab *s;
+  void *tmp;
+
+  assert(pool != NULL);
+  if ((tmp = pool->free_list) != NULL) {
+    pool->free_list = *(void **) tmp;
+  } else {
+    if ((pool->current == NULL) || (pool->next == pool->slab_items)) {
+      /* Slab courant épuisé: on passe au suivant, qui existe déjà après
+       * un pool_clear, ou on en alloue un nouveau.
+       */
+      if ((pool->current != NULL) && (pool->current->next != NULL)) {
+        pool->current = pool->current->next;
+      } else if ((pool->current == NULL) && (pool->slabs != NULL)) {
+        pool->current = pool->slabs;
+      } else {
+        if ((s = (PoolSlab *) malloc(sizeof(PoolSlab) +
+                                     pool->slab_items*pool->item_size)) == NULL) {
+#ifdef DEBUG
+          fprintf(stderr, "pool_alloc: erreur d'allocation mémoire.\n");
+#endif
+          return NULL;
+        }
+        s->next = NULL;
+        if (pool->current == NULL)
+          pool->slabs = s;
+        else
+          pool->current->next = s;
+        pool->current = s;
+        pool->nslabs += 1;
+      }
+      pool->next = 0;
+    }
+    tmp = pool_slab_item(pool, pool->current, pool->next);
+    pool->next += 1;
+  }
+  pool->size += 1;
+  return tmp;
+}
+
+/* pool_release -- rend à la réserve un objet obtenu par pool_alloc.
+ * Complexité: O(1)
+ */
+void pool_release(Pool *pool, void *item)
+{
+  assert((pool != NULL) && (item != NULL) && (pool->size > 0));
+  *(void **) item = pool->free_list;
+  pool->free_list = item;
+  pool->size -= 1;
+}
+
+/* pool_clear -- rend d'un coup tous les objets à la réserve. Les slabs
+ * sont gardés pour etre réutilisés, et non rendus au système.
+ * Complexité: O(1)
+ */
+void pool_clear(Pool *pool)
+{
+  assert(pool != NULL);
+  pool->current = NULL;
+  pool->next = 0;
+  pool->free_list = NULL;
+  pool->size = 0;
+}
+
+/* pool_size -- renvoie le nombre d'objets alloués (et pas encore rendus).
+ * Complexité: O(1)
+ */
+int pool_size(Pool *pool)
+{
+  assert(pool != NULL);
+  return pool->size;
+}
@@ -0,0 +1,66 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <stddef.h>
+
+/* Réserve d'objets de taille fixe.
+ * Les objets sont découpés dans de grands blocs (slabs) de slab_items
+ * objets, et les objets rendus sont gardés dans une liste libre (chainée
+ * à l'intérieur des objets eux-memes) pour etre réutilisés. Une
+ * allocation ou une libération ne coute donc presque jamais un appel à
+ * malloc ou free, et la réserve entière se libère en un appel à free par
+ * slab, sans parcourir les objets.
+ * Les objets sont alignés comme un pointeur.
+ */
+
+typedef struct _pool_slab {
+  struct _pool_slab *next;      /* Slab suivant */
+} PoolSlab;
+
+typedef struct {
+  size_t item_size;             /* Taille d'un objet (arrondie) */
+  int slab_items;               /* Nombre d'objets par slab */
+  int size;                     /* Nombre d'objets alloués */
+  int nslabs;                   /* Nombre de slabs */
+  PoolSlab *slabs;              /* Tous les slabs */
+  PoolSlab *current;            /* Slab en cours de découpage */
+  int next;                     /* Indice du prochain objet neuf de current */
+  void *free_list;              /* Objets rendus */
+} Pool;
+
+/* pool_new -- crée une réserve d'objets de item_size octets, découpés
+ * par slabs de slab_items objets. Aucun slab n'est alloué tout de suite.
+ * Retourne un pointeur sur cette réserve, ou NULL en cas d'échec.
+ * Complexité: O(1)
+ */
+extern Pool *pool_new(size_t item_size, int slab_items);
+
+/* pool_free -- détruit une réserve et libère la mémoire qu'elle occupait,
+ * y compris celle des objets qui n'ont pas été rendus.
+ * Complexité: O(nombre de slabs)
+ */
+extern void pool_free(Pool *pool);
+
+/* pool_alloc -- renvoie un objet (non initialisé) de la réserve, ou NULL
+ * en cas d'erreur d'allocation mémoire.
+ * Complexité: O(1)
+ */
+extern void *pool_alloc(Pool *pool);
+
+/* pool_release -- rend à la réserve un objet obtenu par pool_alloc.
+ * Complexité: O(1)
+ */
+extern void pool_release(Pool *pool, void *item);
+
+/* pool_clear -- rend d'un coup tous les objets à la réserve. Les slabs
+ * sont gardés pour etre réutilisés, et non rendus au système.
+ * Complexité: O(1)
+ */
+extern void pool_clear(Pool *pool);
+
+/* pool_size -- renvoie le nombre d'objets alloués (et pas encore rendus).
+ * Complexité: O(1)
+ */
+extern int pool_size(Pool *pool);
+
+#endif /* POOL_H */
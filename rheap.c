@@ -0,0 +1,242 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "rheap.h"
+
+/* rheap_create -- crée un tas radix vide.
+ * Retourne un pointeur sur ce nouveau tas, ou NULL si la création
+ * ne s'est pas bien passée.
+ * Complexité: O(1)
+ */
+RHeap *rheap_create(void)
+{
+  RHeap *tmp;
+  int i;
+
+  if ((tmp = (RHeap *) malloc(sizeof(RHeap))) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "rheap_create: erreur d'allocation mémoire.\n");
+#endif
+    return NULL;
+  }
+  tmp->size = 0;
+  tmp->last = 0;
+  for (i = 0; i < RHEAP_BUCKETS; i++) {
+    tmp->buckets[i].size = tmp->buckets[i].max = 0;
+    tmp->buckets[i].tab = NULL;
+  }
+  return tmp;
+}
+
+/* rheap_free -- détruit un tas radix et libère la mémoire qu'il occupait.
+ * Complexité: O(1)
+ */
+void rheap_free(RHeap *h)
+{
+  int i;
+
+  assert(h != NULL);
+  for (i = 0; i < RHEAP_BUCKETS; i++)
+    if (h->buckets[i].tab != NULL) free(h->buckets[i].tab);
+  free(h);
+}
+
+/* rheap_size -- renvoie la taille effective du tas.
+ * Complexité: O(1)
+ */
+int rheap_size(RHeap *h)
+{
+  assert(h != NULL);
+  return h->size;
+}
+
+/* rheap_bucket (fonction interne) -- renvoie le numéro du panier dans
+ * lequel doit etre rangée la clé key: 0 si elle est égale à la dernière
+ * clé extraite, et sinon 1 + la position du bit de poids fort qui les
+ * distingue.
+ * Complexité: O(1)
+ */
+static int rheap_bucket(RHeap *h, unsigned int key)
+{
+  unsigned int x = key ^ h->last;
+#ifndef __GNUC__
+  int n = 0;
+#endif
+
+  if (x == 0) return 0;
+#ifdef __GNUC__
+  return RHEAP_BUCKETS - 1 - __builtin_clz(x);
+#else
+  while (x != 0) {
+    n += 1;
+    x >>= 1;
+  }
+  return n;
+#endif
+}
+
+/* rheap_reserve (fonction interne) -- agrandit si nécessaire le panier b
+ * pour qu'il puisse recevoir n éléments de plus.
+ * La valeur de retour indique si l'agrandissement s'est bien passé.
+ * Complexité: O(b->size)
+ */
+static int rheap_reserve(RHeapBucket *b, int n)
+{
+  RHeapItem *tab;
+  int max;
+
+  if (b->size + n <= b->max)
+    return 1;
+  for (max = (b->max == 0) ? 16 : b->max; max < b->size + n; max *= 2)
+    ;
+  if ((tab = (RHeapItem *) realloc(b->tab, max*sizeof(RHeapItem))) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "rheap_reserve: erreur d'allocation mémoire.\n");
+#endif
+    return 0;
+  }
+  b->tab = tab;
+  b->max = max;
+  return 1;
+}
+
+/* rheap_refill (fonction interne) -- si le panier 0 est vide, prend le
+ * premier panier non vide, fait de sa plus petite clé la nouvelle
+ * dernière clé extraite, et redistribue son contenu dans les paniers
+ * inférieurs. Le panier 0 contient alors les plus petites clés du tas.
+ * La place nécessaire est réservée avant tout déplacement, de sorte
+ * qu'en cas d'erreur d'allocation le tas reste inchangé.
+ * La valeur de retour indique si l'opération s'est bien passée.
+ * Complexité: O(ln(C)) amortie
+ */
+static int rheap_refill(RHeap *h)
+{
+  RHeapBucket *b;
+  unsigned int min, old_last = h->last;
+  int count[RHEAP_BUCKETS];
+  int i, j, k;
+
+  if ((h->size == 0) || (h->buckets[0].size != 0))
+    return 1;
+  for (i = 1; h->buckets[i].size == 0; i++)
+    ;
+  b = &h->buckets[i];
+  min = b->tab[0].key;
+  for (j = 1; j < b->size; j++)
+    if (b->tab[j].key < min) min = b->tab[j].key;
+  h->last = min;
+  /* Toutes les clés du panier i partagent leurs bits au dessus du bit
+   * i-1 avec min: elles retombent toutes dans des paniers < i.
+   */
+  for (k = 0; k < i; k++)
+    count[k] = 0;
+  for (j = 0; j < b->size; j++)
+    count[rheap_bucket(h, b->tab[j].key)] += 1;
+  for (k = 0; k < i; k++)
+    if (!rheap_reserve(&h->buckets[k], count[k])) {
+      h->last = old_last;
+      return 0;
+    }
+  for (j = 0; j < b->size; j++) {
+    k = rheap_bucket(h, b->tab[j].key);
+    h->buckets[k].tab[h->buckets[k].size++] = b->tab[j];
+  }
+  b->size = 0;
+  return 1;
+}
+
+/* rheap_root -- renvoie la donnée de plus petite clé du tas.
+ * Ne modifie pas le contenu du tas, mais peut réorganiser ses paniers.
+ * Renvoie NULL en cas d'erreur d'allocation mémoire.
+ * Complexité: O(ln(C)) amortie
+ */
+void *rheap_root(RHeap *h)
+{
+  assert((h != NULL) && (h->size != 0));
+  if (!rheap_refill(h)) return NULL;
+  return h->buckets[0].tab[h->buckets[0].size-1].item;
+}
+
+/* rheap_root_key -- renvoie la plus petite clé du tas.
+ * Complexité: O(ln(C)) amortie
+ */
+unsigned int rheap_root_key(RHeap *h)
+{
+  RHeapBucket *b;
+  unsigned int min;
+  int i;
+
+  assert((h != NULL) && (h->size != 0));
+  if (rheap_refill(h))
+    return h->last;
+  /* Pas assez de mémoire pour redistribuer: cherche le minimum sur place */
+  for (i = 1; h->buckets[i].size == 0; i++)
+    ;
+  b = &h->buckets[i];
+  for (min = b->tab[0].key, i = 1; i < b->size; i++)
+    if (b->tab[i].key < min) min = b->tab[i].key;
+  return min;
+}
+
+/* rheap_extract_root -- retire l'élément de plus petite clé du tas et
+ * renvoie sa donnée, ou NULL si le tas est vide (ou en cas d'erreur
+ * d'allocation mémoire).
+ * Complexité: O(ln(C)) amortie
+ */
+void *rheap_extract_root(RHeap *h)
+{
+  RHeapBucket *b;
+
+  assert(h != NULL);
+  if ((h->size == 0) || !rheap_refill(h)) return NULL;
+  b = &h->buckets[0];
+  h->size -= 1;
+  b->size -= 1;
+  return b->tab[b->size].item;
+}
+
+/* rheap_insert -- insère la donnée item avec la clé key.
+ * La valeur de retour indique si l'insertion s'est bien passée (0 en
+ * cas d'erreur d'allocation ou si key est plus petite que la dernière
+ * clé extraite ou consultée par rheap_root/rheap_root_key).
+ * Complexité: O(1) amortie
+ */
+int rheap_insert(RHeap *h, unsigned int key, void *item)
+{
+  RHeapBucket *b;
+
+  assert((h != NULL) && (item != NULL));
+  if (key < h->last)
+    return 0;
+  b = &h->buckets[rheap_bucket(h, key)];
+  if (!rheap_reserve(b, 1))
+    return 0;
+  b->tab[b->size].key = key;
+  b->tab[b->size].item = item;
+  b->size += 1;
+  h->size += 1;
+  return 1;
+}
+
+/* rheap_print -- affiche le tas à l'écran, panier par panier. Chaque
+ * donnée est affichée avec la fonction print_data.
+ * Complexité: O(rheap_size(h))
+ */
+void rheap_print(RHeap *h, void (*print_data)(void *))
+{
+  int i, j;
+
+  assert((h != NULL) && (print_data != NULL));
+  printf("(");
+  for (i = 0; i < RHEAP_BUCKETS; i++) {
+    if (h->buckets[i].size == 0) continue;
+    printf("[%d:", i);
+    for (j = 0; j < h->buckets[i].size; j++) {
+      printf(" %u=", h->buckets[i].tab[j].key);
+      print_data(h->buckets[i].tab[j].item);
+    }
+    printf("]");
+  }
+  printf(")");
+}
@@ -0,0 +1,84 @@
+#ifndef RHEAP_H
+#define RHEAP_H
+
+/* Tas radix (radix heap): file de priorité monotone à clés entières non
+ * signées. Les clés extraites doivent former une suite croissante: on ne
+ * peut insérer une clé plus petite que la dernière clé extraite (c'est le
+ * cas de l'algorithme de Dijkstra ou de Prim avec des poids entiers
+ * positifs).
+ * Les éléments sont répartis dans RHEAP_BUCKETS paniers selon le bit de
+ * poids fort qui distingue leur clé de la dernière clé extraite. Chaque
+ * élément ne peut que descendre de panier, ce qui donne des opérations en
+ * O(ln(C)) amorti, où C est l'écart maximal entre deux clés.
+ */
+
+#define RHEAP_BUCKETS 33        /* 1 + nombre de bits d'une clé */
+
+typedef struct {
+  unsigned int key;
+  void *item;
+} RHeapItem;
+
+typedef struct {
+  int size;                     /* Nombre d'éléments dans le panier */
+  int max;                      /* Taille du tableau tab */
+  RHeapItem *tab;
+} RHeapBucket;
+
+typedef struct {
+  int size;                     /* Taille effective du tas */
+  unsigned int last;            /* Dernière clé extraite */
+  RHeapBucket buckets[RHEAP_BUCKETS];
+} RHeap;
+
+/* rheap_create -- crée un tas radix vide.
+ * Retourne un pointeur sur ce nouveau tas, ou NULL si la création
+ * ne s'est pas bien passée.
+ * Complexité: O(1)
+ */
+extern RHeap *rheap_create(void);
+
+/* rheap_free -- détruit un tas radix et libère la mémoire qu'il occupait.
+ * Complexité: O(1)
+ */
+extern void rheap_free(RHeap *h);
+
+/* rheap_size -- renvoie la taille effective du tas.
+ * Complexité: O(1)
+ */
+extern int rheap_size(RHeap *h);
+
+/* rheap_root -- renvoie la donnée de plus petite clé du tas.
+ * Ne modifie pas le contenu du tas, mais peut réorganiser ses paniers.
+ * Renvoie NULL en cas d'erreur d'allocation mémoire.
+ * Complexité: O(ln(C)) amortie
+ */
+extern void *rheap_root(RHeap *h);
+
+/* rheap_root_key -- renvoie la plus petite clé du tas.
+ * Complexité: O(ln(C)) amortie
+ */
+extern unsigned int rheap_root_key(RHeap *h);
+
+/* rheap_extract_root -- retire l'élément de plus petite clé du tas et
+ * renvoie sa donnée, ou NULL si le tas est vide (ou en cas d'erreur
+ * d'allocation mémoire).
+ * Complexité: O(ln(C)) amortie
+ */
+extern void *rheap_extract_root(RHeap *h);
+
+/* rheap_insert -- insère la donnée item avec la clé key.
+ * La valeur de retour indique si l'insertion s'est bien passée (0 en
+ * cas d'erreur d'allocation ou si key est plus petite que la dernière
+ * clé extraite ou consultée par rheap_root/rheap_root_key).
+ * Complexité: O(1) amortie
+ */
+extern int rheap_insert(RHeap *h, unsigned int key, void *item);
+
+/* rheap_print -- affiche le tas à l'écran, panier par panier. Chaque
+ * donnée est affichée avec la fonction print_data.
+ * Complexité: O(rheap_size(h))
+ */
+extern void rheap_print(RHeap *h, void (*print_data)(void *));
+
+#endif /* RHEAP_H */
@@ -0,0 +1,329 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "skiplist.h"
+
+/* skiplist_lt (fonction interne) -- teste si a est strictement inférieur
+ * à b.
+ * Complexité: O(C(le))
+ */
+#define skiplist_lt(list, a, b) (!(list)->le((b), (a)))
+
+/* skiplist_node_new (fonction interne) -- renvoie un noeud de height
+ * niveaux contenant item, ou NULL en cas d'erreur d'allocation mémoire.
+ * Complexité: O(height)
+ */
+static SkipNode *skiplist_node_new(void *item, int height)
+{
+  SkipNode *tmp;
+  int l;
+
+  if ((tmp = (SkipNode *) malloc(sizeof(SkipNode) + height*sizeof(SkipNode *))) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "skiplist_node_new: erreur d'allocation mémoire.\n");
+#endif
+    return NULL;
+  }
+  tmp->item = item;
+  tmp->height = height;
+  for (l = 0; l < height; l++)
+    tmp->next[l] = NULL;
+  return tmp;
+}
+
+/* skiplist_new -- crée une liste vide, triée selon la relation d'ordre
+ * total le.
+ * Retourne un pointeur sur cette liste, ou NULL en cas d'erreur
+ * d'allocation mémoire.
+ * Complexité: O(1)
+ */
+SkipList *skiplist_new(int (*le)(void *, void *))
+{
+  SkipList *tmp;
+
+  assert(le != NULL);
+  if ((tmp = (SkipList *) malloc(sizeof(SkipList))) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "skiplist_new: erreur d'allocation mémoire.\n");
+#endif
+    return NULL;
+  }
+  if ((tmp->head = skiplist_node_new(NULL, SKIPLIST_MAX_LEVEL)) == NULL) {
+    free(tmp);
+    return NULL;
+  }
+  tmp->level = 1;
+  tmp->length = 0;
+  tmp->le = le;
+  tmp->seed = 2463534242u;
+  tmp->current = NULL;
+  return tmp;
+}
+
+/* skiplist_free -- détruit la liste et libère la mémoire qu'elle
+ * occupait (mais pas celle occupée par les données).
+ * Complexité: O(skiplist_length(list))
+ */
+void skiplist_free(SkipList *list)
+{
+  SkipNode *n, *next;
+
+  assert(list != NULL);
+  for (n = list->head; n != NULL; n = next) {
+    next = n->next[0];
+    free(n);
+  }
+  free(list);
+}
+
+/* skiplist_empty -- teste si la liste est vide.
+ * Complexité: O(1)
+ */
+int skiplist_empty(SkipList *list)
+{
+  assert(list != NULL);
+  return (list->length == 0);
+}
+
+/* skiplist_length -- renvoie le nombre de données de la liste.
+ * Complexité: O(1)
+ */
+int skiplist_length(SkipList *list)
+{
+  assert(list != NULL);
+  return list->length;
+}
+
+/* skiplist_random_height (fonction interne) -- tire la hauteur d'un
+ * nouveau noeud: h avec une probabilité (3/4)*(1/4)^(h-1).
+ * Complexité: O(1)
+ */
+static int skiplist_random_height(SkipList *list)
+{
+  unsigned int x = list->seed;
+  int height = 1;
+
+  /* xorshift32 */
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  list->seed = x;
+  while ((height < SKIPLIST_MAX_LEVEL) && ((x & 3) == 0)) {
+    height += 1;
+    x >>= 2;
+  }
+  return height;
+}
+
+/* skiplist_search (fonction interne) -- descend dans la liste en
+ * s'arretant, à chaque niveau l, sur le dernier noeud dont la donnée est
+ * strictement inférieure à item (strict != 0) ou inférieure ou égale à
+ * item (strict == 0), et range ce noeud dans update[l].
+ * Renvoie le noeud qui suit update[0] au niveau 0.
+ * Complexité: O(ln(skiplist_length(list))) en moyenne
+ */
+static SkipNode *skiplist_search(SkipList *list, void *item, int strict,
+                                 SkipNode **update)
+{
+  SkipNode *x = list->head;
+  SkipNode *next;
+  int l;
+
+  for (l = list->level - 1; l >= 0; l--) {
+    while (((next = x->next[l]) != NULL) &&
+           (strict ? skiplist_lt(list, next->item, item) : list->le(next->item, item)))
+      x = next;
+    if (update != NULL) update[l] = x;
+  }
+  return x->next[0];
+}
+
+/* skiplist_insert -- insère item à sa place (après les données qui lui
+ * sont égales), et en fait l'élément courant.
+ * La valeur de retour indique si l'insertion s'est bien passée.
+ * Complexité: O(ln(skiplist_length(list))) en moyenne
+ */
+int skiplist_insert(SkipList *list, void *item)
+{
+  SkipNode *update[SKIPLIST_MAX_LEVEL];
+  SkipNode *n;
+  int l, height;
+
+  assert((list != NULL) && (item != NULL));
+  skiplist_search(list, item, 0, update);
+  height = skiplist_random_height(list);
+  if ((n = skiplist_node_new(item, height)) == NULL)
+    return 0;
+  for (; list->level < height; list->level++)
+    update[list->level] = list->head;
+  for (l = 0; l < height; l++) {
+    n->next[l] = update[l]->next[l];
+    update[l]->next[l] = n;
+  }
+  list->length += 1;
+  list->current = n;
+  return 1;
+}
+
+/* skiplist_find -- renvoie la première donnée égale à item, et en fait
+ * l'élément courant. Si elle est absente, renvoie NULL (et l'élément
+ * courant ne change pas).
+ * Complexité: O(ln(skiplist_length(list))) en moyenne
+ */
+void *skiplist_find(SkipList *list, void *item)
+{
+  SkipNode *n;
+
+  assert((list != NULL) && (item != NULL));
+  n = skiplist_search(list, item, 1, NULL);
+  if ((n == NULL) || !list->le(n->item, item))
+    return NULL;
+  list->current = n;
+  return n->item;
+}
+
+/* skiplist_lower_bound -- renvoie la première donnée qui n'est pas
+ * strictement inférieure à item, et en fait l'élément courant. S'il n'y
+ * en a pas, renvoie NULL et l'élément courant est après la fin.
+ * Complexité: O(ln(skiplist_length(list))) en moyenne
+ */
+void *skiplist_lower_bound(SkipList *list, void *item)
+{
+  assert((list != NULL) && (item != NULL));
+  list->current = skiplist_search(list, item, 1, NULL);
+  return skiplist_current(list);
+}
+
+/* skiplist_unlink (fonction interne) -- retire le noeud n, précédé au
+ * niveau l par update[l], libère le noeud et renvoie sa donnée.
+ * Complexité: O(hauteur de n)
+ */
+static void *skiplist_unlink(SkipList *list, SkipNode *n, SkipNode **update)
+{
+  void *item = n->item;
+  int l;
+
+  for (l = 0; l < n->height; l++)
+    update[l]->next[l] = n->next[l];
+  while ((list->level > 1) && (list->head->next[list->level-1] == NULL))
+    list->level -= 1;
+  if (list->current == n)
+    list->current = n->next[0];
+  list->length -= 1;
+  free(n);
+  return item;
+}
+
+/* skiplist_remove -- retire de la liste la première donnée égale à item
+ * et la renvoie, ou renvoie NULL si elle est absente. Si c'était
+ * l'élément courant, son suivant le devient.
+ * Complexité: O(ln(skiplist_length(list))) en moyenne
+ */
+void *skiplist_remove(SkipList *list, void *item)
+{
+  SkipNode *update[SKIPLIST_MAX_LEVEL];
+  SkipNode *n;
+
+  assert((list != NULL) && (item != NULL));
+  /* Le premier noeud qui n'est pas avant item est précédé par update[l]
+   * à tous ses niveaux.
+   */
+  n = skiplist_search(list, item, 1, update);
+  if ((n == NULL) || !list->le(n->item, item))
+    return NULL;
+  return skiplist_unlink(list, n, update);
+}
+
+/* skiplist_first -- renvoie la plus petite donnée de la liste (sans la
+ * retirer), ou NULL si la liste est vide.
+ * Complexité: O(1)
+ */
+void *skiplist_first(SkipList *list)
+{
+  assert(list != NULL);
+  return (list->head->next[0] == NULL) ? NULL : list->head->next[0]->item;
+}
+
+/* skiplist_extract_first -- retire la plus petite donnée de la liste et
+ * la renvoie, ou renvoie NULL si la liste est vide. Si c'était l'élément
+ * courant, son suivant le devient.
+ * Complexité: O(1) en moyenne
+ */
+void *skiplist_extract_first(SkipList *list)
+{
+  SkipNode *update[SKIPLIST_MAX_LEVEL];
+  SkipNode *n;
+  int l;
+
+  assert(list != NULL);
+  if ((n = list->head->next[0]) == NULL)
+    return NULL;
+  /* Le premier noeud est précédé par la tete à tous ses niveaux */
+  for (l = 0; l < n->height; l++)
+    update[l] = list->head;
+  return skiplist_unlink(list, n, update);
+}
+
+/* skiplist_reset -- place l'élément courant sur la plus petite donnée.
+ * Complexité: O(1)
+ */
+void skiplist_reset(SkipList *list)
+{
+  assert(list != NULL);
+  list->current = list->head->next[0];
+}
+
+/* skiplist_current -- renvoie l'élément courant, ou NULL si la liste est
+ * vide ou qu'on a dépassé la fin.
+ * Complexité: O(1)
+ */
+void *skiplist_current(SkipList *list)
+{
+  assert(list != NULL);
+  return (list->current == NULL) ? NULL : list->current->item;
+}
+
+/* skiplist_next -- avance d'un élément dans l'ordre et renvoie l'élément
+ * d'arrivée, ou NULL si on a dépassé la fin.
+ * Complexité: O(1)
+ */
+void *skiplist_next(SkipList *list)
+{
+  assert(list != NULL);
+  if (list->current == NULL)
+    return NULL;
+  list->current = list->current->next[0];
+  return skiplist_current(list);
+}
+
+/* skiplist_foreach -- appelle func(donnée, data) sur chaque donnée de la
+ * liste, dans l'ordre. Ne modifie pas l'élément courant.
+ * Complexité: O(skiplist_length(list)*complexité(func))
+ */
+void skiplist_foreach(SkipList *list, void (*func)(void *, void *), void *data)
+{
+  SkipNode *n;
+
+  assert((list != NULL) && (func != NULL));
+  for (n = list->head->next[0]; n != NULL; n = n->next[0])
+    func(n->item, data);
+}
+
+/* skiplist_print -- affiche la liste sur la sortie standard sous la forme
+ * "(item1, item2, ...)", en appelant print_item sur chaque donnée. Ne
+ * modifie pas l'élément courant.
+ * Complexité: O(skiplist_length(list)*C(print_item))
+ */
+void skiplist_print(SkipList *list, void (*print_item)(void *))
+{
+  SkipNode *n;
+
+  assert((list != NULL) && (print_item != NULL));
+  putchar('(');
+  for (n = list->head->next[0]; n != NULL; n = n->next[0]) {
+    if (n != list->head->next[0]) printf(", ");
+    print_item(n->item);
+  }
+  putchar(')');
+}
@@ -0,0 +1,135 @@
+#ifndef SKIPLIST_H
+#define SKIPLIST_H
+
+/* Liste à enjambements (skip list): un conteneur trié, qui remplace
+ * slist_insert_sorted quand la liste devient longue.
+ * Chaque noeud est chainé au niveau 0 (la liste triée complète) et,
+ * avec une probabilité 1/4 de plus à chaque fois, aux niveaux suivants.
+ * Une recherche part du plus haut niveau et descend d'un niveau chaque
+ * fois qu'elle dépasserait la donnée cherchée: elle ne visite ainsi
+ * qu'un nombre logarithmique de noeuds en moyenne.
+ *
+ * Comme pour slist_insert_sorted, l'ordre est donné par une relation
+ * d'ordre total le (<= par ex.); deux données sont égales si chacune est
+ * "inférieure ou égale" à l'autre. Les doublons sont permis: une donnée
+ * est insérée après celles qui lui sont égales.
+ *
+ * La liste a un élément courant, comme SList: skiplist_reset,
+ * skiplist_next et skiplist_current parcourent les données dans l'ordre,
+ * et skiplist_find ou skiplist_lower_bound se placent sur la donnée
+ * trouvée.
+ */
+
+#define SKIPLIST_MAX_LEVEL 16     /* Suffit pour 4^16 données */
+
+typedef struct _skipnode {
+  void *item;                   /* La donnée */
+  int height;                   /* Nombre de niveaux du noeud */
+  struct _skipnode *next[];     /* next[l] = noeud suivant au niveau l */
+} SkipNode;
+
+typedef struct {
+  int level;                    /* Nombre de niveaux utilisés */
+  int length;                   /* Nombre de données */
+  int (*le)(void *, void *);    /* Relation d'ordre */
+  unsigned int seed;            /* Etat du générateur aléatoire */
+  SkipNode *head;               /* Noeud de tete (sans donnée) */
+  SkipNode *current;            /* Elément courant (NULL: fin) */
+} SkipList;
+
+/* skiplist_new -- crée une liste vide, triée selon la relation d'ordre
+ * total le.
+ * Retourne un pointeur sur cette liste, ou NULL en cas d'erreur
+ * d'allocation mémoire.
+ * Complexité: O(1)
+ */
+extern SkipList *skiplist_new(int (*le)(void *, void *));
+
+/* skiplist_free -- détruit la liste et libère la mémoire qu'elle
+ * occupait (mais pas celle occupée par les données).
+ * Complexité: O(skiplist_length(list))
+ */
+extern void skiplist_free(SkipList *list);
+
+/* skiplist_empty -- teste si la liste est vide.
+ * Complexité: O(1)
+ */
+extern int skiplist_empty(SkipList *list);
+
+/* skiplist_length -- renvoie le nombre de données de la liste.
+ * Complexité: O(1)
+ */
+extern int skiplist_length(SkipList *list);
+
+/* skiplist_insert -- insère item à sa place (après les données qui lui
+ * sont égales), et en fait l'élément courant.
+ * La valeur de retour indique si l'insertion s'est bien passée.
+ * Complexité: O(ln(skiplist_length(list))) en moyenne
+ */
+extern int skiplist_insert(SkipList *list, void *item);
+
+/* skiplist_find -- renvoie la première donnée égale à item, et en fait
+ * l'élément courant. Si elle est absente, renvoie NULL (et l'élément
+ * courant ne change pas).
+ * Complexité: O(ln(skiplist_length(list))) en moyenne
+ */
+extern void *skiplist_find(SkipList *list, void *item);
+
+/* skiplist_lower_bound -- renvoie la première donnée qui n'est pas
+ * strictement inférieure à item, et en fait l'élément courant. S'il n'y
+ * en a pas, renvoie NULL et l'élément courant est après la fin.
+ * Complexité: O(ln(skiplist_length(list))) en moyenne
+ */
+extern void *skiplist_lower_bound(SkipList *list, void *item);
+
+/* skiplist_remove -- retire de la liste la première donnée égale à item
+ * et la renvoie, ou renvoie NULL si elle est absente. Si c'était
+ * l'élément courant, son suivant le devient.
+ * Complexité: O(ln(skiplist_length(list))) en moyenne
+ */
+extern void *skiplist_remove(SkipList *list, void *item);
+
+/* skiplist_first -- renvoie la plus petite donnée de la liste (sans la
+ * retirer), ou NULL si la liste est vide.
+ * Complexité: O(1)
+ */
+extern void *skiplist_first(SkipList *list);
+
+/* skiplist_extract_first -- retire la plus petite donnée de la liste et
+ * la renvoie, ou renvoie NULL si la liste est vide. Si c'était l'élément
+ * courant, son suivant le devient.
+ * Complexité: O(1) en moyenne
+ */
+extern void *skiplist_extract_first(SkipList *list);
+
+/* skiplist_reset -- place l'élément courant sur la plus petite donnée.
+ * Complexité: O(1)
+ */
+extern void skiplist_reset(SkipList *list);
+
+/* skiplist_current -- renvoie l'élément courant, ou NULL si la liste est
+ * vide ou qu'on a dépassé la fin.
+ * Complexité: O(1)
+ */
+extern void *skiplist_current(SkipList *list);
+
+/* skiplist_next -- avance d'un élément dans l'ordre et renvoie l'élément
+ * d'arrivée, ou NULL si on a dépassé la fin.
+ * Complexité: O(1)
+ */
+extern void *skiplist_next(SkipList *list);
+
+/* skiplist_foreach -- appelle func(donnée, data) sur chaque donnée de la
+ * liste, dans l'ordre. Ne modifie pas l'élément courant.
+ * Complexité: O(skiplist_length(list)*complexité(func))
+ */
+extern void skiplist_foreach(SkipList *list, void (*func)(void *, void *), void *data);
+
+/* skiplist_print -- affiche la liste sur la sortie standard sous la forme
+ * "(item1, item2, ...)", en appelant print_item sur chaque donnée. Ne
+ * modifie pas l'élément courant.
+ * Complexité: O(skiplist_length(list)*C(print_item))
+ */
+extern void skiplist_print(SkipList *list, void (*print_item)(void *));
+
+#endif /* SKIPLIST_H */
@@ -1,27 +1,159 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <assert.h>
+#include <pthread.h>
 
 #include "slist.h"
 
+/* Les noeuds des listes créées par slist_new viennent d'une réserve
+ * partagée par tous les threads. Pour ne pas prendre son verrou à chaque
+ * noeud, chaque thread garde un petit cache de noeuds libres, qu'il
+ * remplit ou vide par lots de SLIST_CACHE_BATCH noeuds. Le cache d'un
+ * thread est rendu à la réserve quand le thread se termine.
+ */
+#define SLIST_SLAB_ITEMS 1024
+#define SLIST_CACHE_BATCH 32
+
+typedef struct {
+  Node *free;                   /* Noeuds libres, chainés par next */
+  int count;                    /* Nombre de noeuds libres */
+} SListCache;
+
+static Pool *slist_pool = NULL;
+static pthread_mutex_t slist_pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t slist_pool_once = PTHREAD_ONCE_INIT;
+static pthread_key_t slist_cache_key;
+static _Thread_local SListCache slist_cache = { NULL, 0 };
+
+/* slist_cache_flush (fonction interne) -- rend à la réserve partagée les
+ * noeuds du cache cache, sauf les keep premiers.
+ * Complexité: O(nombre de noeuds rendus)
+ */
+static void slist_cache_flush(SListCache *cache, int keep)
+{
+  Node *n;
+
+  pthread_mutex_lock(&slist_pool_lock);
+  while (cache->count > keep) {
+    n = cache->free;
+    cache->free = n->next;
+    cache->count -= 1;
+    pool_release(slist_pool, n);
+  }
+  pthread_mutex_unlock(&slist_pool_lock);
+}
+
+/* slist_cache_exit (fonction interne) -- appelée à la fin d'un thread
+ * pour rendre son cache.
+ * Complexité: O(SLIST_CACHE_BATCH)
+ */
+static void slist_cache_exit(void *cache)
+{
+  slist_cache_flush((SListCache *) cache, 0);
+}
+
+/* slist_pool_init (fonction interne) -- crée la réserve partagée (une
+ * seule fois).
+ * Complexité: O(1)
+ */
+static void slist_pool_init(void)
+{
+  slist_pool = pool_new(sizeof(Node), SLIST_SLAB_ITEMS);
+  pthread_key_create(&slist_cache_key, slist_cache_exit);
+}
+
+/* slist_node_alloc (fonction interne) -- renvoie un noeud neuf pour la
+ * liste list, ou NULL en cas d'erreur d'allocation mémoire.
+ * Complexité: O(1) amortie
+ */
+static Node *slist_node_alloc(SList *list)
+{
+  Node *n;
+
+  if (list->pool != NULL)
+    return (Node *) pool_alloc(list->pool);
+  if (slist_cache.count == 0) {
+    /* Remplit le cache avec un lot de noeuds de la réserve partagée */
+    pthread_once(&slist_pool_once, slist_pool_init);
+    if (slist_pool == NULL)
+      return NULL;
+    pthread_setspecific(slist_cache_key, &slist_cache);
+    pthread_mutex_lock(&slist_pool_lock);
+    while (slist_cache.count < SLIST_CACHE_BATCH) {
+      if ((n = (Node *) pool_alloc(slist_pool)) == NULL)
+        break;
+      n->next = slist_cache.free;
+      slist_cache.free = n;
+      slist_cache.count += 1;
+    }
+    pthread_mutex_unlock(&slist_pool_lock);
+    if (slist_cache.count == 0)
+      return NULL;
+  }
+  n = slist_cache.free;
+  slist_cache.free = n->next;
+  slist_cache.count -= 1;
+  return n;
+}
+
+/* slist_node_release (fonction interne) -- rend le noeud n de la liste
+ * list à sa réserve.
+ * Complexité: O(1) amortie
+ */
+static void slist_node_release(SList *list, Node *n)
+{
+  if (list->pool != NULL) {
+    pool_release(list->pool, n);
+    return;
+  }
+  if (slist_cache.count == 0) {
+    /* Le cache doit etre rendu à la fin du thread */
+    pthread_once(&slist_pool_once, slist_pool_init);
+    pthread_setspecific(slist_cache_key, &slist_cache);
+  }
+  n->next = slist_cache.free;
+  slist_cache.free = n;
+  slist_cache.count += 1;
+  if (slist_cache.count > 2*SLIST_CACHE_BATCH)
+    slist_cache_flush(&slist_cache, SLIST_CACHE_BATCH);
+}
+
 /* slist_new  -- renvoie un pointeur sur une nouvelle list (vide)
  * ou bien NULL en cas d'erreur d'allocation mémoire.
+ * Ses noeuds viennent de la réserve partagée.
  * Complexité: O(1)
  */
 SList *slist_new()
+{
+  return slist_new_with_pool(NULL);
+}
+
+/* slist_new_with_pool -- renvoie un pointeur sur une nouvelle liste
+ * (vide) dont les noeuds viennent de la réserve pool (créée par
+ * pool_new(sizeof(Node), ...)), ou bien NULL en cas d'erreur d'allocation
+ * mémoire. Avec pool == NULL, équivaut à slist_new.
+ * Une réserve peut etre partagée par plusieurs listes, mais pas entre
+ * plusieurs threads. Pour détruire toutes ces listes d'un coup, on les
+ * abandonne par slist_drop puis on vide la réserve (pool_clear ou
+ * pool_free).
+ * Complexité: O(1)
+ */
+SList *slist_new_with_pool(Pool *pool)
 {
   SList *tmp;
 
+  assert((pool == NULL) || (pool->item_size >= sizeof(Node)));
   tmp = (SList *) malloc(sizeof(SList));
   if (tmp == NULL) {
 #ifdef DEBUG
-    fprintf(stderr, "slist_new: erreur d'allocation mémoire.\n");
+    fprintf(stderr, "slist_new_with_pool: erreur d'allocation mémoire.\n");
 #endif
     return NULL;
   }
   tmp->current = tmp->first = NULL;
   tmp->index = 0;
   tmp->length = 0;
+  tmp->pool = pool;
   return tmp;
 }
 
@@ -38,11 +170,23 @@ void slist_free(SList *list)
   assert(list != NULL);
   for (n = list->first; n != NULL; n = next) {
     next = n->next;
-    free(n);
+    slist_node_release(list, n);
   }
   free(list);
 }
 
+/* slist_drop -- détruit la liste passée en paramètre sans rendre ses
+ * noeuds: ils restent alloués dans la réserve de la liste, qui les
+ * récupérera tous d'un coup par pool_clear ou pool_free. N'a de sens que
+ * pour une liste créée par slist_new_with_pool.
+ * Complexité: O(1)
+ */
+void slist_drop(SList *list)
+{
+  assert((list != NULL) && (list->pool != NULL));
+  free(list);
+}
+
 /* slist_empty -- teste si une liste est vide (ie allouée mais ne
  * contenant aucun élément).
  * Complexité: O(1)
@@ -140,6 +284,72 @@ void *slist_find(SList *list, void *item, int (*pred)(void *, void *))
     return NULL;                /* Pas trouvé */
 }
 
+/* slist_lookup -- renvoie le premier élément de la liste égal à item
+ * (d'après le prédicat pred), ou NULL s'il n'y en a pas. Contrairement à
+ * slist_find, n'écrit pas dans la liste: le noeud courant ne change pas,
+ * et plusieurs threads peuvent chercher en meme temps dans la meme
+ * liste.
+ * Complexité: O(longueur(list)*C(pred))
+ */
+void *slist_lookup(const SList *list, void *item, int (*pred)(void *, void *))
+{
+  Node *n;
+
+  assert((list != NULL) && (pred != NULL));
+  for (n = list->first; n != NULL; n = n->next)
+    if (pred(n->item, item)) return n->item;
+  return NULL;
+}
+
+/* slist_iter_first -- place l'itérateur iter sur le premier élément de la
+ * liste et renvoie cet élément, ou NULL si la liste est vide.
+ * Un parcours complet s'écrit:
+ *   for (x = slist_iter_first(list, &iter); x != NULL; x = slist_iter_next(&iter))
+ * Complexité: O(1)
+ */
+void *slist_iter_first(const SList *list, SListIter *iter)
+{
+  assert((list != NULL) && (iter != NULL));
+  iter->node = list->first;
+  iter->index = 1;
+  return slist_iter_current(iter);
+}
+
+/* slist_iter_next -- avance l'itérateur iter d'un élément et renvoie
+ * l'élément d'arrivée, ou NULL si on a dépassé la fin de la liste.
+ * Complexité: O(1)
+ */
+void *slist_iter_next(SListIter *iter)
+{
+  assert(iter != NULL);
+  if (iter->node == NULL)
+    return NULL;
+  iter->node = iter->node->next;
+  iter->index += 1;
+  return slist_iter_current(iter);
+}
+
+/* slist_iter_current -- renvoie l'élément sur lequel se trouve
+ * l'itérateur iter, ou NULL si on a dépassé la fin de la liste.
+ * Complexité: O(1)
+ */
+void *slist_iter_current(const SListIter *iter)
+{
+  assert(iter != NULL);
+  return (iter->node == NULL) ? NULL : iter->node->item;
+}
+
+/* slist_iter_index -- renvoie le numéro (de 1 à longueur(liste)) de
+ * l'élément sur lequel se trouve l'itérateur iter, ou 0 si on a dépassé
+ * la fin de la liste.
+ * Complexité: O(1)
+ */
+int slist_iter_index(const SListIter *iter)
+{
+  assert(iter != NULL);
+  return (iter->node == NULL) ? 0 : iter->index;
+}
+
 /* slist_insert -- insère un élément spécifié à la position courante
  * dans la liste. Les éléments qui suivent se retrouvent décalés d'un cran.
  * Le pointeur de liste est positionnée sur le nouveau noeud.
@@ -152,7 +362,7 @@ int slist_insert(SList *list, void *item)
   Node *new;
 
   assert((list != NULL) && (item != NULL)); /* Est-ce raisonnable ? */
-  if ((new = (Node *) malloc(sizeof(Node))) == NULL) {
+  if ((new = slist_node_alloc(list)) == NULL) {
 #ifdef DEBUG
     fprintf(stderr, "slist_insert: erreur d'allocation mémoire\n");
 #endif
@@ -200,7 +410,7 @@ int slist_insert_sorted(SList *list, void *item, int (*cmp_func)(void *, void *)
   }
   if (slist_current(list) == NULL) {
     /* On a dépassé la fin de la liste */
-    if ((new = (Node *) malloc(sizeof(Node))) == NULL) {
+    if ((new = slist_node_alloc(list)) == NULL) {
 #ifdef DEBUG
       fprintf(stderr, "slist_insert_sorted: erreur d'allocation mémoire\n");
 #endif
@@ -234,12 +444,12 @@ int slist_remove(SList *list)
   if (list->current->next != NULL) {
     node = list->current->next->next;
     list->current->item = list->current->next->item;
-    free(list->current->next);
+    slist_node_release(list, list->current->next);
     list->current->next = node;
     list->length -= 1;
   } else if (slist_length(list) == 1) {
     /* Liste avec un seul élément */
-    free(list->current);
+    slist_node_release(list, list->current);
     list->current = list->first = NULL;
     list->length = 0;
     list->index = 0;
@@ -254,7 +464,7 @@ int slist_remove(SList *list)
       list->current = list->current->next;
     }
     /* node pointe sur l'avant-dernier noeud */
-    free(node->next);
+    slist_node_release(list, node->next);
     node->next = NULL;
     list->current = list->first;
     list->index = 1;
@@ -266,32 +476,34 @@ int slist_remove(SList *list)
 /* slist_foreach -- appelle une fonction donnée successivement sur
  * chaque élément de la liste. La fonction à appeler prend 2 paramètres:
  * un pointeur sur l'élément, et un pointeur générique (pour des données
- * utilisateur).
+ * utilisateur). Ne modifie pas le noeud courant.
  * Complexité: O(longueur(list)*complexité(func))
  */
-void slist_foreach(SList *list, void (*func)(void *, void *), void *data)
+void slist_foreach(const SList *list, void (*func)(void *, void *), void *data)
 {
+  SListIter iter;
+  void *item;
+
   assert((list != NULL) && (func != NULL));
-  for (slist_reset(list); slist_current(list) != NULL; slist_next(list))
-    func(slist_current(list), data);
+  for (item = slist_iter_first(list, &iter); item != NULL; item = slist_iter_next(&iter))
+    func(item, data);
 }
 
 /* slist_print -- affiche une liste sur la sortie standard sous la
  * forme: "(item1, item2, ...)". Fait appel à la fonction print_item pour
- * afficher chacun des éléments.
+ * afficher chacun des éléments. Ne modifie pas le noeud courant.
  * Complexité: O(longueur(list)*C(print_item))
  */
-void slist_print(SList *list, void (*print_item)(void *))
+void slist_print(const SList *list, void (*print_item)(void *))
 {
+  SListIter iter;
+  void *item;
+
   assert((list != NULL) && (print_item != NULL));
   putchar('(');
-  if (!slist_empty(list)) {
-    slist_reset(list);
-    print_item(slist_current(list));
-    while (slist_next(list) != NULL) {
-      printf(", ");
-      print_item(slist_current(list));
-    }
+  for (item = slist_iter_first(list, &iter); item != NULL; item = slist_iter_next(&iter)) {
+    if (slist_iter_index(&iter) > 1) printf(", ");
+    print_item(item);
   }
   putchar(')');
 }
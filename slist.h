@@ -1,6 +1,8 @@
 #ifndef SLIST_H
 #define SLIST_H
 
+#include "pool.h"
+
 typedef struct _node {
   void *item;
   struct _node *next;
@@ -11,10 +13,23 @@ typedef struct {
   Node *current;
   int index;
   int length;
+  Pool *pool;                   /* Réserve des noeuds (NULL: réserve partagée) */
 } SList;
 
+/* Itérateur externe: à la différence du noeud courant de la liste, il
+ * appartient à celui qui parcourt la liste (il s'alloue sur la pile),
+ * si bien que plusieurs parcours peuvent avoir lieu en meme temps sans
+ * écrire dans la liste. Il n'est plus valable si la liste est modifiée.
+ */
+typedef struct {
+  Node *node;                   /* Noeud courant (NULL: fin) */
+  int index;                    /* Numéro du noeud courant */
+} SListIter;
+
 extern SList *slist_new();
+extern SList *slist_new_with_pool(Pool *pool);
 extern void   slist_free(SList *list);
+extern void   slist_drop(SList *list);
 
 extern int  slist_empty(SList *list);
 extern int  slist_length(SList *list);
@@ -24,12 +39,18 @@ extern void *slist_current(SList *list);
 extern void slist_reset(SList *list);
 extern void *slist_next(SList *list);
 extern void *slist_find(SList *list, void *item, int (*equal_func)(void *, void *));
+extern void *slist_lookup(const SList *list, void *item, int (*equal_func)(void *, void *));
+
+extern void *slist_iter_first(const SList *list, SListIter *iter);
+extern void *slist_iter_next(SListIter *iter);
+extern void *slist_iter_current(const SListIter *iter);
+extern int   slist_iter_index(const SListIter *iter);
 
 extern int slist_insert(SList *list, void *item);
 extern int slist_insert_sorted(SList *list, void *item, int (*cmp_func)(void*, void*));
 extern int slist_remove(SList *list);
 
-extern void slist_foreach(SList *list, void (*func)(void *, void *), void *data);
-extern void slist_print(SList *list, void (*print_item)(void *));
+extern void slist_foreach(const SList *list, void (*func)(void *, void *), void *data);
+extern void slist_print(const SList *list, void (*print_item)(void *));
 
 #endif /* SLIST_H */
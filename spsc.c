@@ -0,0 +1,205 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "spsc.h"
+
+/* spsc_new -- crée une nouvelle file pouvant contenir au moins max_size
+ * éléments (la capacité est arrondie à la puissance de 2 supérieure).
+ * Retourne un pointeur sur cette file, ou NULL si l'allocation n'a pas
+ * pu se faire.
+ * Complexité: O(1)
+ */
+SpscFifo *spsc_new(int max_size)
+{
+  SpscFifo *tmp;
+  size_t size;
+
+  assert(max_size > 0);
+  for (size = 1; size < (size_t) max_size; size *= 2)
+    ;
+  if (posix_memalign((void **) &tmp, SPSC_CACHE_LINE, sizeof(SpscFifo)) != 0) {
+#ifdef DEBUG
+    fprintf(stderr, "spsc_new: erreur d'allocation mémoire.\n");
+#endif
+    return NULL;
+  }
+  if ((tmp->items = (void **) malloc(size*sizeof(void *))) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "spsc_new: erreur d'allocation mémoire.\n");
+#endif
+    free(tmp);
+    return NULL;
+  }
+  atomic_init(&tmp->head, 0);
+  atomic_init(&tmp->tail, 0);
+  tmp->head_cache = tmp->tail_cache = 0;
+  tmp->mask = size - 1;
+  return tmp;
+}
+
+/* spsc_free -- détruit une file et libère la mémoire qu'elle occupait.
+ * Complexité: O(1)
+ */
+void spsc_free(SpscFifo *fifo)
+{
+  assert((fifo != NULL) && (fifo->items != NULL));
+  free(fifo->items);
+  free(fifo);
+}
+
+/* spsc_max_size -- retourne le nombre maximum d'éléments que la file
+ * peut contenir.
+ * Complexité: O(1)
+ */
+int spsc_max_size(SpscFifo *fifo)
+{
+  assert(fifo != NULL);
+  return (int) (fifo->mask + 1);
+}
+
+/* spsc_length -- retourne la longueur de la file. Si l'autre thread est
+ * actif, la valeur n'est qu'indicative.
+ * Complexité: O(1)
+ */
+int spsc_length(SpscFifo *fifo)
+{
+  size_t head, tail;
+
+  assert(fifo != NULL);
+  /* head d'abord: tail ne peut alors qu'etre en avance sur lui */
+  head = atomic_load_explicit(&fifo->head, memory_order_acquire);
+  tail = atomic_load_explicit(&fifo->tail, memory_order_acquire);
+  return (tail > head) ? (int) (tail - head) : 0;
+}
+
+/* spsc_empty -- détermine si une file est vide (meme remarque que pour
+ * spsc_length).
+ * Complexité: O(1)
+ */
+int spsc_empty(SpscFifo *fifo)
+{
+  return spsc_length(fifo) == 0;
+}
+
+/* spsc_put -- insère un nouvel élément dans la file. A n'appeler que
+ * depuis le thread producteur.
+ * La valeur de retour indique si l'insertion s'est faite (0 si la file
+ * est pleine).
+ * Complexité: O(1)
+ */
+int spsc_put(SpscFifo *fifo, void *item)
+{
+  size_t tail;
+
+  assert((fifo != NULL) && (item != NULL));
+  tail = atomic_load_explicit(&fifo->tail, memory_order_relaxed);
+  if (tail - fifo->head_cache > fifo->mask) {
+    /* Pleine d'après notre copie: relit le vrai head */
+    fifo->head_cache = atomic_load_explicit(&fifo->head, memory_order_acquire);
+    if (tail - fifo->head_cache > fifo->mask)
+      return 0;
+  }
+  fifo->items[tail & fifo->mask] = item;
+  atomic_store_explicit(&fifo->tail, tail + 1, memory_order_release);
+  return 1;
+}
+
+/* spsc_get -- retire un élément de la file et renvoie un pointeur sur
+ * son contenu. A n'appeler que depuis le thread consommateur.
+ * Retourne NULL si la file est vide.
+ * Complexité: O(1)
+ */
+void *spsc_get(SpscFifo *fifo)
+{
+  size_t head;
+  void *ret;
+
+  assert(fifo != NULL);
+  head = atomic_load_explicit(&fifo->head, memory_order_relaxed);
+  if (head == fifo->tail_cache) {
+    /* Vide d'après notre copie: relit le vrai tail */
+    fifo->tail_cache = atomic_load_explicit(&fifo->tail, memory_order_acquire);
+    if (head == fifo->tail_cache)
+      return NULL;
+  }
+  ret = fifo->items[head & fifo->mask];
+  atomic_store_explicit(&fifo->head, head + 1, memory_order_release);
+  return ret;
+}
+
+/* spsc_copy_in (fonction interne) -- recopie n éléments de items dans
+ * le tableau circulaire à partir de l'indice pos, en deux morceaux si
+ * on passe par la fin du tableau.
+ * Complexité: O(n)
+ */
+static void spsc_copy_in(SpscFifo *fifo, size_t pos, void **items, size_t n)
+{
+  size_t i = pos & fifo->mask;
+  size_t first = fifo->mask + 1 - i;
+
+  if (first > n) first = n;
+  memcpy(fifo->items + i, items, first*sizeof(void *));
+  memcpy(fifo->items, items + first, (n - first)*sizeof(void *));
+}
+
+/* spsc_copy_out (fonction interne) -- recopie dans out n éléments du
+ * tableau circulaire à partir de l'indice pos.
+ * Complexité: O(n)
+ */
+static void spsc_copy_out(SpscFifo *fifo, size_t pos, void **out, size_t n)
+{
+  size_t i = pos & fifo->mask;
+  size_t first = fifo->mask + 1 - i;
+
+  if (first > n) first = n;
+  memcpy(out, fifo->items + i, first*sizeof(void *));
+  memcpy(out + first, fifo->items, (n - first)*sizeof(void *));
+}
+
+/* spsc_put_n -- insère au plus n éléments du tableau items, dans l'ordre.
+ * A n'appeler que depuis le thread producteur.
+ * Renvoie le nombre d'éléments effectivement insérés.
+ * Complexité: O(n)
+ */
+int spsc_put_n(SpscFifo *fifo, void **items, int n)
+{
+  size_t tail, room;
+
+  assert((fifo != NULL) && (items != NULL) && (n >= 0));
+  tail = atomic_load_explicit(&fifo->tail, memory_order_relaxed);
+  room = fifo->mask + 1 - (tail - fifo->head_cache);
+  if (room < (size_t) n) {
+    fifo->head_cache = atomic_load_explicit(&fifo->head, memory_order_acquire);
+    room = fifo->mask + 1 - (tail - fifo->head_cache);
+  }
+  if (room > (size_t) n) room = n;
+  if (room == 0) return 0;
+  spsc_copy_in(fifo, tail, items, room);
+  atomic_store_explicit(&fifo->tail, tail + room, memory_order_release);
+  return (int) room;
+}
+
+/* spsc_get_n -- retire au plus n éléments de la file et les range dans
+ * out. A n'appeler que depuis le thread consommateur.
+ * Renvoie le nombre d'éléments effectivement retirés.
+ * Complexité: O(n)
+ */
+int spsc_get_n(SpscFifo *fifo, void **out, int n)
+{
+  size_t head, avail;
+
+  assert((fifo != NULL) && (out != NULL) && (n >= 0));
+  head = atomic_load_explicit(&fifo->head, memory_order_relaxed);
+  avail = fifo->tail_cache - head;
+  if (avail < (size_t) n) {
+    fifo->tail_cache = atomic_load_explicit(&fifo->tail, memory_order_acquire);
+    avail = fifo->tail_cache - head;
+  }
+  if (avail > (size_t) n) avail = n;
+  if (avail == 0) return 0;
+  spsc_copy_out(fifo, head, out, avail);
+  atomic_store_explicit(&fifo->head, head + avail, memory_order_release);
+  return (int) avail;
+}
@@ -0,0 +1,90 @@
+#ifndef SPSC_H
+#define SPSC_H
+
+#include <stddef.h>
+#include <stdatomic.h>
+
+/* File sans verrou pour un seul producteur et un seul consommateur.
+ * La capacité est une puissance de 2: les indices avancent sans jamais
+ * revenir à 0, et la case correspondante est obtenue par un masque.
+ * Le producteur et le consommateur ont chacun leur ligne de cache: head
+ * n'est écrit que par le consommateur, tail que par le producteur, et
+ * chacun garde une copie locale de l'indice de l'autre pour ne relire
+ * l'indice partagé que lorsque la file semble pleine (ou vide).
+ */
+
+#define SPSC_CACHE_LINE 64
+
+typedef struct {
+  /* Consommateur */
+  _Alignas(SPSC_CACHE_LINE) atomic_size_t head; /* Prochaine case à lire */
+  size_t tail_cache;            /* Dernière valeur de tail lue */
+  /* Producteur */
+  _Alignas(SPSC_CACHE_LINE) atomic_size_t tail; /* Prochaine case à écrire */
+  size_t head_cache;            /* Dernière valeur de head lue */
+  /* Partagé, en lecture seule */
+  _Alignas(SPSC_CACHE_LINE) size_t mask; /* Capacité - 1 */
+  void **items;                 /* Tableau contenant les éléments */
+} SpscFifo;
+
+/* spsc_new -- crée une nouvelle file pouvant contenir au moins max_size
+ * éléments (la capacité est arrondie à la puissance de 2 supérieure).
+ * Retourne un pointeur sur cette file, ou NULL si l'allocation n'a pas
+ * pu se faire.
+ * Complexité: O(1)
+ */
+extern SpscFifo *spsc_new(int max_size);
+
+/* spsc_free -- détruit une file et libère la mémoire qu'elle occupait.
+ * Complexité: O(1)
+ */
+extern void spsc_free(SpscFifo *fifo);
+
+/* spsc_max_size -- retourne le nombre maximum d'éléments que la file
+ * peut contenir.
+ * Complexité: O(1)
+ */
+extern int spsc_max_size(SpscFifo *fifo);
+
+/* spsc_length -- retourne la longueur de la file. Si l'autre thread est
+ * actif, la valeur n'est qu'indicative.
+ * Complexité: O(1)
+ */
+extern int spsc_length(SpscFifo *fifo);
+
+/* spsc_empty -- détermine si une file est vide (meme remarque que pour
+ * spsc_length).
+ * Complexité: O(1)
+ */
+extern int spsc_empty(SpscFifo *fifo);
+
+/* spsc_put -- insère un nouvel élément dans la file. A n'appeler que
+ * depuis le thread producteur.
+ * La valeur de retour indique si l'insertion s'est faite (0 si la file
+ * est pleine).
+ * Complexité: O(1)
+ */
+extern int spsc_put(SpscFifo *fifo, void *item);
+
+/* spsc_get -- retire un élément de la file et renvoie un pointeur sur
+ * son contenu. A n'appeler que depuis le thread consommateur.
+ * Retourne NULL si la file est vide.
+ * Complexité: O(1)
+ */
+extern void *spsc_get(SpscFifo *fifo);
+
+/* spsc_put_n -- insère au plus n éléments du tableau items, dans l'ordre.
+ * A n'appeler que depuis le thread producteur.
+ * Renvoie le nombre d'éléments effectivement insérés.
+ * Complexité: O(n)
+ */
+extern int spsc_put_n(SpscFifo *fifo, void **items, int n);
+
+/* spsc_get_n -- retire au plus n éléments de la file et les range dans
+ * out. A n'appeler que depuis le thread consommateur.
+ * Renvoie le nombre d'éléments effectivement retirés.
+ * Complexité: O(n)
+ */
+extern int spsc_get_n(SpscFifo *fifo, void **out, int n);
+
+#endif /* SPSC_H */
@@ -0,0 +1,228 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "topk.h"
+
+/* topk_new -- crée une sélection des k plus petits éléments selon rel.
+ * Retourne un pointeur sur cette sélection, ou NULL en cas d'échec.
+ * Complexité: O(1)
+ */
+TopK *topk_new(int k, relation rel)
+{
+  TopK *tmp;
+
+  assert((k > 0) && (rel != NULL));
+  if ((tmp = (TopK *) malloc(sizeof(TopK))) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "topk_new: erreur d'allocation mémoire.\n");
+#endif
+    return NULL;
+  }
+  if ((tmp->tab = (void **) malloc(k*sizeof(void *))) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "topk_new: erreur d'allocation mémoire.\n");
+#endif
+    free(tmp);
+    return NULL;
+  }
+  tmp->size = 0;
+  tmp->k = k;
+  tmp->rel = rel;
+  return tmp;
+}
+
+/* topk_free -- détruit une sélection et libère la mémoire qu'elle
+ * occupait (mais pas celle des éléments).
+ * Complexité: O(1)
+ */
+void topk_free(TopK *t)
+{
+  assert(t != NULL);
+  if (t->tab != NULL) free(t->tab);
+  free(t);
+}
+
+/* topk_size -- renvoie le nombre d'éléments retenus (au plus k).
+ * Complexité: O(1)
+ */
+int topk_size(TopK *t)
+{
+  assert(t != NULL);
+  return t->size;
+}
+
+/* topk_max_size -- renvoie k.
+ * Complexité: O(1)
+ */
+int topk_max_size(TopK *t)
+{
+  assert(t != NULL);
+  return t->k;
+}
+
+/* topk_root -- renvoie le plus "grand" des éléments retenus, ie celui
+ * qu'il faut battre pour entrer dans la sélection une fois qu'elle est
+ * pleine.
+ * Complexité: O(1)
+ */
+void *topk_root(TopK *t)
+{
+  assert((t != NULL) && (t->size != 0));
+  return t->tab[0];
+}
+
+/* topk_shift_down (fonction interne) -- fait descendre à sa place
+ * l'élément en position i. Le tas est ordonné à l'envers de rel: chaque
+ * père est plus "grand" que ses fils.
+ * Complexité: O(ln(k))
+ */
+static void topk_shift_down(TopK *t, int i)
+{
+  void *item = t->tab[i];
+  int max_i = t->size - 1;
+  int next_i;
+
+  while (heap_left_son(i) <= max_i) {
+    /* Détermine le plus grand des fils */
+    next_i = heap_left_son(i);
+    if ((heap_right_son(i) <= max_i) &&
+        t->rel(t->tab[heap_right_son(i)], t->tab[next_i]))
+      next_i = heap_right_son(i);
+    if (!t->rel(t->tab[next_i], item))
+      break;
+    t->tab[i] = t->tab[next_i];
+    i = next_i;
+  }
+  t->tab[i] = item;
+}
+
+/* topk_shift_up (fonction interne) -- fait remonter à sa place
+ * l'élément en position i.
+ * Complexité: O(ln(k))
+ */
+static void topk_shift_up(TopK *t, int i)
+{
+  void *item = t->tab[i];
+  int f;
+
+  while (i > 0) {
+    f = heap_father(i);
+    if (!t->rel(item, t->tab[f]))
+      break;
+    t->tab[i] = t->tab[f];
+    i = f;
+  }
+  t->tab[i] = item;
+}
+
+/* topk_offer -- propose un élément à la sélection.
+ * Renvoie l'élément écarté: NULL si item a été retenu sans en écarter
+ * d'autre, item lui-meme s'il a été rejeté, ou l'ancien élément qu'il a
+ * remplacé. L'appelant peut ainsi libérer les éléments écartés.
+ * Complexité: O(1) si item est rejeté, O(ln(k)) sinon
+ */
+void *topk_offer(TopK *t, void *item)
+{
+  void *old;
+
+  assert((t != NULL) && (t->tab != NULL) && (item != NULL));
+  if (t->size < t->k) {
+    t->tab[t->size++] = item;
+    topk_shift_up(t, t->size-1);
+    return NULL;
+  }
+  /* Rejet immédiat de tout ce qui ne passe pas devant la racine */
+  if (t->rel(item, t->tab[0]))
+    return item;
+  old = t->tab[0];
+  t->tab[0] = item;
+  topk_shift_down(t, 0);
+  return old;
+}
+
+/* topk_sort -- range les éléments retenus dans out, du plus petit au plus
+ * grand, et vide la sélection. out doit pouvoir contenir topk_size(t)
+ * éléments.
+ * Renvoie le nombre d'éléments rangés.
+ * Complexité: O(k ln(k))
+ */
+int topk_sort(TopK *t, void **out)
+{
+  int n;
+
+  assert((t != NULL) && (out != NULL));
+  n = t->size;
+  /* La racine est le plus grand: on remplit out par la fin */
+  while (t->size > 0) {
+    out[t->size-1] = t->tab[0];
+    t->size -= 1;
+    if (t->size > 0) {
+      t->tab[0] = t->tab[t->size];
+      topk_shift_down(t, 0);
+    }
+  }
+  return n;
+}
+
+/* psort_new -- prépare le tri partiel des size premiers éléments du
+ * tableau tab (de taille max_size) selon rel.
+ * Comme pour heap_build, le tableau n'est pas recopié: il doit avoir été
+ * alloué par malloc et appartient ensuite au tri partiel.
+ * Retourne un pointeur sur le tri partiel, ou NULL en cas d'échec (le
+ * tableau reste alors à l'appelant).
+ * Complexité: O(size)
+ */
+PSort *psort_new(void **tab, int size, int max_size, relation rel)
+{
+  PSort *tmp;
+
+  assert((tab != NULL) && (rel != NULL));
+  if ((tmp = (PSort *) malloc(sizeof(PSort))) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "psort_new: erreur d'allocation mémoire.\n");
+#endif
+    return NULL;
+  }
+  if ((tmp->heap = heap_build(tab, size, max_size, rel)) == NULL) {
+    free(tmp);
+    return NULL;
+  }
+  return tmp;
+}
+
+/* psort_free -- détruit un tri partiel et libère la mémoire qu'il
+ * occupait (y compris le tableau, mais pas les éléments).
+ * Complexité: O(1)
+ */
+void psort_free(PSort *ps)
+{
+  assert(ps != NULL);
+  heap_free(ps->heap);
+  free(ps);
+}
+
+/* psort_remaining -- renvoie le nombre d'éléments pas encore distribués.
+ * Complexité: O(1)
+ */
+int psort_remaining(PSort *ps)
+{
+  assert(ps != NULL);
+  return heap_size(ps->heap);
+}
+
+/* psort_next -- range dans out les n plus petits éléments pas encore
+ * distribués, dans l'ordre croissant.
+ * Renvoie le nombre d'éléments rangés (moins de n s'il n'en reste pas
+ * assez).
+ * Complexité: O(n ln(psort_remaining(ps)))
+ */
+int psort_next(PSort *ps, void **out, int n)
+{
+  int i;
+
+  assert((ps != NULL) && (out != NULL) && (n >= 0));
+  for (i = 0; (i < n) && (heap_size(ps->heap) != 0); i++)
+    out[i] = heap_extract_root(ps->heap);
+  return i;
+}
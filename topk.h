@@ -0,0 +1,105 @@
+#ifndef TOPK_H
+#define TOPK_H
+
+#include "heap.h"
+
+/* Sélection des k plus petits éléments d'un flot, et tri partiel
+ * incrémental. Les deux utilisent la meme convention que Heap: rel(a, b)
+ * est vraie si a doit etre placé après b (ie a >= b pour avoir les plus
+ * petits). Pour obtenir les k plus grands, il suffit d'inverser rel.
+ */
+
+/* TopK garde les k plus petits éléments vus jusqu'ici dans un tas de
+ * taille k dont la racine est le plus "grand" d'entre eux: un nouvel
+ * élément qui ne passe pas devant la racine est rejeté en une seule
+ * comparaison.
+ */
+typedef struct {
+  int size;                     /* Nombre d'éléments retenus */
+  int k;                        /* Nombre maximum d'éléments retenus */
+  relation rel;                 /* Relation d'ordre des éléments */
+  void **tab;                   /* Tas des éléments retenus */
+} TopK;
+
+/* PSort distribue, à la demande, les éléments d'un tableau par paquets,
+ * dans l'ordre croissant, sans avoir à trier le tableau entier.
+ */
+typedef struct {
+  Heap *heap;                   /* Éléments pas encore distribués */
+} PSort;
+
+/* topk_new -- crée une sélection des k plus petits éléments selon rel.
+ * Retourne un pointeur sur cette sélection, ou NULL en cas d'échec.
+ * Complexité: O(1)
+ */
+extern TopK *topk_new(int k, relation rel);
+
+/* topk_free -- détruit une sélection et libère la mémoire qu'elle
+ * occupait (mais pas celle des éléments).
+ * Complexité: O(1)
+ */
+extern void topk_free(TopK *t);
+
+/* topk_size -- renvoie le nombre d'éléments retenus (au plus k).
+ * Complexité: O(1)
+ */
+extern int topk_size(TopK *t);
+
+/* topk_max_size -- renvoie k.
+ * Complexité: O(1)
+ */
+extern int topk_max_size(TopK *t);
+
+/* topk_root -- renvoie le plus "grand" des éléments retenus, ie celui
+ * qu'il faut battre pour entrer dans la sélection une fois qu'elle est
+ * pleine.
+ * Complexité: O(1)
+ */
+extern void *topk_root(TopK *t);
+
+/* topk_offer -- propose un élément à la sélection.
+ * Renvoie l'élément écarté: NULL si item a été retenu sans en écarter
+ * d'autre, item lui-meme s'il a été rejeté, ou l'ancien élément qu'il a
+ * remplacé. L'appelant peut ainsi libérer les éléments écartés.
+ * Complexité: O(1) si item est rejeté, O(ln(k)) sinon
+ */
+extern void *topk_offer(TopK *t, void *item);
+
+/* topk_sort -- range les éléments retenus dans out, du plus petit au plus
+ * grand, et vide la sélection. out doit pouvoir contenir topk_size(t)
+ * éléments.
+ * Renvoie le nombre d'éléments rangés.
+ * Complexité: O(k ln(k))
+ */
+extern int topk_sort(TopK *t, void **out);
+
+/* psort_new -- prépare le tri partiel des size premiers éléments du
+ * tableau tab (de taille max_size) selon rel.
+ * Comme pour heap_build, le tableau n'est pas recopié: il doit avoir été
+ * alloué par malloc et appartient ensuite au tri partiel.
+ * Retourne un pointeur sur le tri partiel, ou NULL en cas d'échec (le
+ * tableau reste alors à l'appelant).
+ * Complexité: O(size)
+ */
+extern PSort *psort_new(void **tab, int size, int max_size, relation rel);
+
+/* psort_free -- détruit un tri partiel et libère la mémoire qu'il
+ * occupait (y compris le tableau, mais pas les éléments).
+ * Complexité: O(1)
+ */
+extern void psort_free(PSort *ps);
+
+/* psort_remaining -- renvoie le nombre d'éléments pas encore distribués.
+ * Complexité: O(1)
+ */
+extern int psort_remaining(PSort *ps);
+
+/* psort_next -- range dans out les n plus petits éléments pas encore
+ * distribués, dans l'ordre croissant.
+ * Renvoie le nombre d'éléments rangés (moins de n s'il n'en reste pas
+ * assez).
+ * Complexité: O(n ln(psort_remaining(ps)))
+ */
+extern int psort_next(PSort *ps, void **out, int n);
+
+#endif /* TOPK_H */
@@ -0,0 +1,288 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "tstack.h"
+
+#if defined(__x86_64__) && !defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+#error "tstack.c doit etre compilé avec -mcx16 (compare-and-swap de 128 bits)"
+#endif
+
+/* tstack_load (fonction interne) -- lit le sommet head. Les deux moitiés
+ * sont lues séparément, le compteur d'abord: si un compare-and-swap avec
+ * cette valeur réussit, le compteur n'a pas changé depuis sa lecture, et
+ * le noeud lu ensuite était donc bien au sommet.
+ * Complexité: O(1)
+ */
+static TStackTop tstack_load(TStackTop *head)
+{
+  TStackTop top;
+
+  top.s.tag = __atomic_load_n(&head->s.tag, __ATOMIC_ACQUIRE);
+  top.s.node = __atomic_load_n(&head->s.node, __ATOMIC_ACQUIRE);
+  return top;
+}
+
+/* tstack_cas (fonction interne) -- remplace le sommet head par node (et
+ * le compteur suivant) s'il vaut encore *top. Sinon, range dans *top la
+ * valeur actuelle du sommet.
+ * La valeur de retour indique si le remplacement s'est fait.
+ * Complexité: O(1)
+ */
+static int tstack_cas(TStackTop *head, TStackTop *top, TNode *node)
+{
+  TStackTop new, old;
+
+  new.s.node = node;
+  new.s.tag = top->s.tag + 1;
+  old.word = __sync_val_compare_and_swap(&head->word, top->word, new.word);
+  if (old.word == top->word)
+    return 1;
+  *top = old;
+  return 0;
+}
+
+/* tstack_push_chain (fonction interne) -- empile sur head la chaine de
+ * noeuds de first à last.
+ * Complexité: O(1) (sans compter les essais répétés en cas de conflit)
+ */
+static void tstack_push_chain(TStackTop *head, TNode *first, TNode *last)
+{
+  TStackTop top = tstack_load(head);
+
+  do
+    atomic_store_explicit(&last->next, top.s.node, memory_order_relaxed);
+  while (!tstack_cas(head, &top, first));
+}
+
+/* tstack_pop_head (fonction interne) -- dépile et renvoie le noeud du
+ * sommet de head, ou NULL si la pile est vide.
+ * Le lien next peut etre lu alors qu'un autre thread vient de dépiler le
+ * noeud et le réutilise: la valeur lue est alors fausse, mais le
+ * compteur du sommet a changé et le compare-and-swap échoue.
+ * Complexité: O(1) (sans compter les essais répétés en cas de conflit)
+ */
+static TNode *tstack_pop_head(TStackTop *head)
+{
+  TStackTop top = tstack_load(head);
+  TNode *next;
+
+  do {
+    if (top.s.node == NULL)
+      return NULL;
+    next = atomic_load_explicit(&top.s.node->next, memory_order_relaxed);
+  } while (!tstack_cas(head, &top, next));
+  return top.s.node;
+}
+
+/* tstack_pop_all_head (fonction interne) -- vide head et renvoie ses
+ * noeuds, chainés du sommet vers le fond.
+ * Complexité: O(1) (sans compter les essais répétés en cas de conflit)
+ */
+static TNode *tstack_pop_all_head(TStackTop *head)
+{
+  TStackTop top = tstack_load(head);
+
+  while ((top.s.node != NULL) && !tstack_cas(head, &top, NULL))
+    ;
+  return top.s.node;
+}
+
+/* tstack_new -- crée une pile vide.
+ * Retourne un pointeur sur cette pile, ou NULL en cas d'erreur
+ * d'allocation mémoire.
+ * Complexité: O(1)
+ */
+TStack *tstack_new()
+{
+  TStack *tmp;
+
+  if (posix_memalign((void **) &tmp, TSTACK_CACHE_LINE, sizeof(TStack)) != 0) {
+#ifdef DEBUG
+    fprintf(stderr, "tstack_new: erreur d'allocation mémoire.\n");
+#endif
+    return NULL;
+  }
+  tmp->top.s.node = tmp->free.s.node = NULL;
+  tmp->top.s.tag = tmp->free.s.tag = 0;
+  return tmp;
+}
+
+/* tstack_free -- détruit une pile et libère la mémoire occupée par ses
+ * noeuds, mais pas celle occupée par les données. Une pile utilisée avec
+ * les fonctions tstack_xxx_node doit avoir été vidée auparavant, ses
+ * noeuds appartenant à l'appelant. Aucun thread ne doit plus l'utiliser.
+ * Complexité: O(nombre de noeuds alloués)
+ */
+void tstack_free(TStack *stack)
+{
+  TNode *node, *next;
+
+  assert(stack != NULL);
+  for (node = stack->top.s.node; node != NULL; node = next) {
+    next = node->next;
+    free(node);
+  }
+  for (node = stack->free.s.node; node != NULL; node = next) {
+    next = node->next;
+    free(node);
+  }
+  free(stack);
+}
+
+/* tstack_empty -- teste si la pile est vide. En présence d'autres
+ * threads, la réponse n'est qu'indicative.
+ * Complexité: O(1)
+ */
+int tstack_empty(TStack *stack)
+{
+  assert(stack != NULL);
+  return __atomic_load_n(&stack->top.s.node, __ATOMIC_RELAXED) == NULL;
+}
+
+/* tstack_node_new (fonction interne) -- renvoie un noeud libre de la
+ * pile, ou à défaut un nouveau noeud, ou NULL en cas d'erreur
+ * d'allocation mémoire.
+ * Complexité: O(1)
+ */
+static TNode *tstack_node_new(TStack *stack)
+{
+  TNode *node;
+
+  if ((node = tstack_pop_head(&stack->free)) != NULL)
+    return node;
+  if ((node = (TNode *) malloc(sizeof(TNode))) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "tstack_node_new: erreur d'allocation mémoire.\n");
+#endif
+    return NULL;
+  }
+  atomic_init(&node->next, NULL);
+  return node;
+}
+
+/* tstack_push -- empile item.
+ * La valeur de retour indique si l'empilement s'est bien passé (0 en
+ * cas d'erreur d'allocation mémoire).
+ * Complexité: O(1) (sans compter les essais répétés en cas de conflit)
+ */
+int tstack_push(TStack *stack, void *item)
+{
+  TNode *node;
+
+  assert(stack != NULL);
+  if ((node = tstack_node_new(stack)) == NULL)
+    return 0;
+  node->item = item;
+  tstack_push_chain(&stack->top, node, node);
+  return 1;
+}
+
+/* tstack_push_batch -- empile les n données de items, items[n-1] se
+ * retrouvant au sommet, en une seule opération: un autre thread voit
+ * les n données apparaitre d'un coup.
+ * La valeur de retour indique si l'empilement s'est bien passé (en cas
+ * d'échec, rien n'est empilé).
+ * Complexité: O(n)
+ */
+int tstack_push_batch(TStack *stack, void **items, int n)
+{
+  TNode *first = NULL, *last = NULL, *node;
+  int i;
+
+  assert((stack != NULL) && (items != NULL) && (n >= 0));
+  /* Chaine les noeuds de items[n-1] (first) à items[0] (last) */
+  for (i = 0; i < n; i++) {
+    if ((node = tstack_node_new(stack)) == NULL) {
+      if (first != NULL)
+        tstack_push_chain(&stack->free, first, last);
+      return 0;
+    }
+    node->item = items[i];
+    atomic_store_explicit(&node->next, first, memory_order_relaxed);
+    if (last == NULL) last = node;
+    first = node;
+  }
+  if (first != NULL)
+    tstack_push_chain(&stack->top, first, last);
+  return 1;
+}
+
+/* tstack_pop -- dépile et renvoie la donnée du sommet, ou NULL si la
+ * pile est vide.
+ * Complexité: O(1) (sans compter les essais répétés en cas de conflit)
+ */
+void *tstack_pop(TStack *stack)
+{
+  TNode *node;
+  void *item;
+
+  assert(stack != NULL);
+  if ((node = tstack_pop_head(&stack->top)) == NULL)
+    return NULL;
+  item = node->item;
+  tstack_push_chain(&stack->free, node, node);
+  return item;
+}
+
+/* tstack_pop_all -- vide la pile en une seule opération, puis appelle
+ * func(donnée, data) sur chacune des données retirées, du sommet vers le
+ * fond. Renvoie le nombre de données retirées.
+ * Complexité: O(nombre de données retirées*C(func))
+ */
+int tstack_pop_all(TStack *stack, void (*func)(void *, void *), void *data)
+{
+  TNode *first, *node, *last = NULL;
+  int n = 0;
+
+  assert((stack != NULL) && (func != NULL));
+  if ((first = tstack_pop_all_head(&stack->top)) == NULL)
+    return 0;
+  for (node = first; node != NULL; node = node->next) {
+    func(node->item, data);
+    last = node;
+    n += 1;
+  }
+  tstack_push_chain(&stack->free, first, last);
+  return n;
+}
+
+/* tstack_push_node -- empile le noeud node, fourni par l'appelant.
+ * Complexité: O(1) (sans compter les essais répétés en cas de conflit)
+ */
+void tstack_push_node(TStack *stack, TNode *node)
+{
+  assert((stack != NULL) && (node != NULL));
+  tstack_push_chain(&stack->top, node, node);
+}
+
+/* tstack_push_chain_node -- empile en une seule opération la chaine de
+ * noeuds qui va de first à last (par les liens next), first se retrouvant
+ * au sommet.
+ * Complexité: O(1) (sans compter les essais répétés en cas de conflit)
+ */
+void tstack_push_chain_node(TStack *stack, TNode *first, TNode *last)
+{
+  assert((stack != NULL) && (first != NULL) && (last != NULL));
+  tstack_push_chain(&stack->top, first, last);
+}
+
+/* tstack_pop_node -- dépile et renvoie le noeud du sommet, ou NULL si la
+ * pile est vide.
+ * Complexité: O(1) (sans compter les essais répétés en cas de conflit)
+ */
+TNode *tstack_pop_node(TStack *stack)
+{
+  assert(stack != NULL);
+  return tstack_pop_head(&stack->top);
+}
+
+/* tstack_pop_all_node -- vide la pile en une seule opération et renvoie
+ * ses noeuds, chainés du sommet vers le fond (NULL si elle était vide).
+ * Complexité: O(1)
+ */
+TNode *tstack_pop_all_node(TStack *stack)
+{
+  assert(stack != NULL);
+  return tstack_pop_all_head(&stack->top);
+}
@@ -0,0 +1,124 @@
+#ifndef TSTACK_H
+#define TSTACK_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+
+/* Pile sans verrou partagée par plusieurs threads (pile de Treiber).
+ * Le sommet est un double mot de 128 bits qui réunit l'adresse du noeud
+ * du sommet et un compteur de 64 bits, incrémenté à chaque modification.
+ * Un empilement ou un dépilement est un seul compare-and-swap sur ce
+ * double mot (cmpxchg16b sur x86-64, d'où l'option -mcx16 du Makefile;
+ * casp ou ldxp/stxp sur AArch64). Le compteur empeche le problème ABA:
+ * un noeud dépilé puis réempilé pendant qu'un autre thread s'apprete à
+ * dépiler fait échouer ce dernier, au lieu de le faire réussir à tort.
+ * Sur 64 bits, le compteur ne revient jamais à une valeur déjà vue (il
+ * faudrait des siècles à un milliard de modifications par seconde).
+ *
+ * Les noeuds ont la forme de ceux de SList (une donnée, puis le lien).
+ * Un thread qui dépile peut lire le lien d'un noeud qu'un autre thread
+ * vient de dépiler: la mémoire d'un noeud ne doit donc pas etre rendue au
+ * système tant que la pile sert, seulement réutilisée. Les fonctions
+ * tstack_push et tstack_pop s'en chargent en gardant les noeuds libres
+ * dans une seconde pile; les fonctions tstack_xxx_node, qui ne manipulent
+ * que des noeuds fournis par l'appelant (pour faire de la pile la liste
+ * libre d'une réserve d'objets par exemple), le laissent à sa charge.
+ * Une meme pile ne doit pas mélanger les deux familles de fonctions.
+ */
+
+#define TSTACK_CACHE_LINE 64
+
+typedef struct _tnode {
+  void *item;                   /* La donnée */
+  struct _tnode *_Atomic next;  /* Noeud suivant (vers le fond de la pile) */
+} TNode;
+
+/* Sommet d'une pile: modifié uniquement par compare-and-swap sur word */
+typedef union {
+  struct {
+    TNode *node;                /* Noeud du sommet */
+    uint64_t tag;               /* Nombre de modifications */
+  } s;
+  unsigned __int128 word;       /* Les deux à la fois (aligné sur 16 octets) */
+} TStackTop;
+
+typedef struct {
+  _Alignas(TSTACK_CACHE_LINE) TStackTop top;  /* Sommet de la pile */
+  _Alignas(TSTACK_CACHE_LINE) TStackTop free; /* Noeuds libres */
+} TStack;
+
+/* tstack_new -- crée une pile vide.
+ * Retourne un pointeur sur cette pile, ou NULL en cas d'erreur
+ * d'allocation mémoire.
+ * Complexité: O(1)
+ */
+extern TStack *tstack_new();
+
+/* tstack_free -- détruit une pile et libère la mémoire occupée par ses
+ * noeuds, mais pas celle occupée par les données. Une pile utilisée avec
+ * les fonctions tstack_xxx_node doit avoir été vidée auparavant, ses
+ * noeuds appartenant à l'appelant. Aucun thread ne doit plus l'utiliser.
+ * Complexité: O(nombre de noeuds alloués)
+ */
+extern void tstack_free(TStack *stack);
+
+/* tstack_empty -- teste si la pile est vide. En présence d'autres
+ * threads, la réponse n'est qu'indicative.
+ * Complexité: O(1)
+ */
+extern int tstack_empty(TStack *stack);
+
+/* tstack_push -- empile item.
+ * La valeur de retour indique si l'empilement s'est bien passé (0 en
+ * cas d'erreur d'allocation mémoire).
+ * Complexité: O(1) (sans compter les essais répétés en cas de conflit)
+ */
+extern int tstack_push(TStack *stack, void *item);
+
+/* tstack_push_batch -- empile les n données de items, items[n-1] se
+ * retrouvant au sommet, en une seule opération: un autre thread voit
+ * les n données apparaitre d'un coup.
+ * La valeur de retour indique si l'empilement s'est bien passé (en cas
+ * d'échec, rien n'est empilé).
+ * Complexité: O(n)
+ */
+extern int tstack_push_batch(TStack *stack, void **items, int n);
+
+/* tstack_pop -- dépile et renvoie la donnée du sommet, ou NULL si la
+ * pile est vide.
+ * Complexité: O(1) (sans compter les essais répétés en cas de conflit)
+ */
+extern void *tstack_pop(TStack *stack);
+
+/* tstack_pop_all -- vide la pile en une seule opération, puis appelle
+ * func(donnée, data) sur chacune des données retirées, du sommet vers le
+ * fond. Renvoie le nombre de données retirées.
+ * Complexité: O(nombre de données retirées*C(func))
+ */
+extern int tstack_pop_all(TStack *stack, void (*func)(void *, void *), void *data);
+
+/* tstack_push_node -- empile le noeud node, fourni par l'appelant.
+ * Complexité: O(1) (sans compter les essais répétés en cas de conflit)
+ */
+extern void tstack_push_node(TStack *stack, TNode *node);
+
+/* tstack_push_chain_node -- empile en une seule opération la chaine de
+ * noeuds qui va de first à last (par les liens next), first se retrouvant
+ * au sommet.
+ * Complexité: O(1) (sans compter les essais répétés en cas de conflit)
+ */
+extern void tstack_push_chain_node(TStack *stack, TNode *first, TNode *last);
+
+/* tstack_pop_node -- dépile et renvoie le noeud du sommet, ou NULL si la
+ * pile est vide.
+ * Complexité: O(1) (sans compter les essais répétés en cas de conflit)
+ */
+extern TNode *tstack_pop_node(TStack *stack);
+
+/* tstack_pop_all_node -- vide la pile en une seule opération et renvoie
+ * ses noeuds, chainés du sommet vers le fond (NULL si elle était vide).
+ * Complexité: O(1)
+ */
+extern TNode *tstack_pop_all_node(TStack *stack);
+
+#endif /* TSTACK_H */
@@ -0,0 +1,200 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "ufifo.h"
+
+/* ufifo_segment_new (fonction interne) -- renvoie un segment libre, pris
+ * dans la réserve s'il y en a, ou NULL si l'allocation n'a pas pu se faire.
+ * Complexité: O(1)
+ */
+static UFifoSegment *ufifo_segment_new(UFifo *fifo)
+{
+    UFifoSegment *seg;
+
+    if (fifo->spare != NULL) {
+        seg = fifo->spare;
+        fifo->spare = seg->next;
+        fifo->nb_spare -= 1;
+    } else if ((seg = (UFifoSegment *) malloc(sizeof(UFifoSegment))) == NULL) {
+#ifdef DEBUG
+        fprintf(stderr, "ufifo_segment_new: erreur d'allocation mémoire.\n");
+#endif
+        return NULL;
+    }
+    seg->next = NULL;
+    return seg;
+}
+
+/* ufifo_segment_release (fonction interne) -- remet un segment vidé dans
+ * la réserve, ou le libère si la réserve est pleine.
+ * Complexité: O(1)
+ */
+static void ufifo_segment_release(UFifo *fifo, UFifoSegment *seg)
+{
+    if (fifo->nb_spare < fifo->max_spare) {
+        seg->next = fifo->spare;
+        fifo->spare = seg;
+        fifo->nb_spare += 1;
+    } else
+        free(seg);
+}
+
+/* ufifo_new -- crée une nouvelle file vide, qui garde au plus max_spare
+ * segments libres en réserve.
+ * Retourne un pointeur sur cette file, ou NULL si l'allocation n'a pas
+ * pu se faire.
+ * Complexité: O(1)
+ */
+UFifo *ufifo_new(int max_spare)
+{
+    UFifo *tmp;
+
+    assert(max_spare >= 0);
+    if ((tmp = (UFifo *) malloc(sizeof(UFifo))) == NULL) {
+#ifdef DEBUG
+        fprintf(stderr, "ufifo_new: erreur d'allocation mémoire.\n");
+#endif
+        return NULL;
+    }
+    tmp->spare = NULL;
+    tmp->nb_spare = 0;
+    tmp->max_spare = max_spare;
+    if ((tmp->first = ufifo_segment_new(tmp)) == NULL) {
+        free(tmp);
+        return NULL;
+    }
+    tmp->last = tmp->first;
+    tmp->oldest = tmp->newest = 0;
+    tmp->length = 0;
+    return tmp;
+}
+
+/* ufifo_free -- détruit une file et libère la mémoire qu'elle occupait.
+ * Complexité: O(ufifo_length(fifo))
+ */
+void ufifo_free(UFifo *fifo)
+{
+    UFifoSegment *seg, *next;
+
+    assert(fifo != NULL);
+    for (seg = fifo->first; seg != NULL; seg = next) {
+        next = seg->next;
+        free(seg);
+    }
+    ufifo_trim(fifo);
+    free(fifo);
+}
+
+/* ufifo_empty -- détermine si une file est vide.
+ * Complexité: O(1)
+ */
+int ufifo_empty(UFifo *fifo)
+{
+    assert(fifo != NULL);
+    return fifo->length == 0;
+}
+
+/* ufifo_length -- retourne la longueur effective d'une file.
+ * Complexité: O(1)
+ */
+int ufifo_length(UFifo *fifo)
+{
+    assert(fifo != NULL);
+    return fifo->length;
+}
+
+/* ufifo_put -- insère un nouvel élément dans la file.
+ * La valeur de retour indique si l'insertion s'est faite (0 seulement
+ * en cas d'erreur d'allocation mémoire).
+ * Complexité: O(1)
+ */
+int ufifo_put(UFifo *fifo, void *item)
+{
+    UFifoSegment *seg;
+
+    assert((fifo != NULL) && (item != NULL));
+    if (fifo->newest == UFIFO_SEGMENT_SIZE) {
+        /* Dernier segment plein: en chaîne un nouveau */
+        if ((seg = ufifo_segment_new(fifo)) == NULL)
+            return 0;
+        fifo->last->next = seg;
+        fifo->last = seg;
+        fifo->newest = 0;
+    }
+    fifo->last->items[fifo->newest++] = item;
+    fifo->length += 1;
+    return 1;
+}
+
+/* ufifo_get -- retire un élément de la file et renvoie un pointeur
+ * sur son contenu.
+ * Retourne NULL si la file est vide.
+ * Complexité: O(1)
+ */
+void *ufifo_get(UFifo *fifo)
+{
+    UFifoSegment *seg;
+    void *ret;
+
+    assert(fifo != NULL);
+    if (fifo->length == 0)
+        return NULL;
+    ret = fifo->first->items[fifo->oldest++];
+    fifo->length -= 1;
+    if (fifo->length == 0) {
+        /* File vide: on repart du début du segment courant */
+        fifo->oldest = fifo->newest = 0;
+        while (fifo->first != fifo->last) {
+            seg = fifo->first;
+            fifo->first = seg->next;
+            ufifo_segment_release(fifo, seg);
+        }
+    } else if (fifo->oldest == UFIFO_SEGMENT_SIZE) {
+        /* Premier segment épuisé: passe au suivant */
+        seg = fifo->first;
+        fifo->first = seg->next;
+        fifo->oldest = 0;
+        ufifo_segment_release(fifo, seg);
+    }
+    return ret;
+}
+
+/* ufifo_trim -- libère tous les segments libres gardés en réserve.
+ * Complexité: O(nombre de segments libres)
+ */
+void ufifo_trim(UFifo *fifo)
+{
+    UFifoSegment *seg;
+
+    assert(fifo != NULL);
+    while ((seg = fifo->spare) != NULL) {
+        fifo->spare = seg->next;
+        free(seg);
+    }
+    fifo->nb_spare = 0;
+}
+
+/* ufifo_print -- affiche une file à l'écran. Chaque élément est affiché en
+ * faisant appel à print_item.
+ * Complexité: O(ufifo_length(fifo))
+ */
+void ufifo_print(UFifo *fifo, void (*print_item)(void *))
+{
+    UFifoSegment *seg;
+    int i, n;
+
+    assert((fifo != NULL) && (print_item != NULL));
+    printf("haut<-");
+    seg = fifo->first;
+    i = fifo->oldest;
+    for (n = 0; n < fifo->length; n++) {
+        if (i == UFIFO_SEGMENT_SIZE) {
+            seg = seg->next;
+            i = 0;
+        }
+        print_item(seg->items[i++]);
+        printf("<-");
+    }
+    printf("bas");
+}
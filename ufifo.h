@@ -0,0 +1,76 @@
+#ifndef UFIFO_H
+#define UFIFO_H
+
+/* File non bornée, formée de segments de taille fixe chaînés entre eux.
+ * Les segments vidés sont gardés de coté pour etre réutilisés (au plus
+ * max_spare d'entre eux), de sorte qu'il n'y a pas d'allocation par
+ * élément, et que la mémoire redescend après un pic d'activité.
+ */
+
+#define UFIFO_SEGMENT_SIZE 255  /* Un segment occupe 256 pointeurs */
+
+typedef struct _ufifo_segment {
+    struct _ufifo_segment *next;
+    void *items[UFIFO_SEGMENT_SIZE];
+} UFifoSegment;
+
+typedef struct {
+    int length;                 /* Nombre d'éléments dans la file */
+    UFifoSegment *first;        /* Segment contenant le plus ancien */
+    UFifoSegment *last;         /* Segment contenant le plus récent */
+    int oldest;                 /* Indice du plus ancien dans first */
+    int newest;                 /* Indice de la première case libre dans last */
+    UFifoSegment *spare;        /* Segments libres, prets à etre réutilisés */
+    int nb_spare;               /* Nombre de segments libres */
+    int max_spare;              /* Nombre maximum de segments libres gardés */
+} UFifo;
+
+/* ufifo_new -- crée une nouvelle file vide, qui garde au plus max_spare
+ * segments libres en réserve.
+ * Retourne un pointeur sur cette file, ou NULL si l'allocation n'a pas
+ * pu se faire.
+ * Complexité: O(1)
+ */
+extern UFifo *ufifo_new(int max_spare);
+
+/* ufifo_free -- détruit une file et libère la mémoire qu'elle occupait.
+ * Complexité: O(ufifo_length(fifo))
+ */
+extern void ufifo_free(UFifo *fifo);
+
+/* ufifo_empty -- détermine si une file est vide.
+ * Complexité: O(1)
+ */
+extern int ufifo_empty(UFifo *fifo);
+
+/* ufifo_length -- retourne la longueur effective d'une file.
+ * Complexité: O(1)
+ */
+extern int ufifo_length(UFifo *fifo);
+
+/* ufifo_put -- insère un nouvel élément dans la file.
+ * La valeur de retour indique si l'insertion s'est faite (0 seulement
+ * en cas d'erreur d'allocation mémoire).
+ * Complexité: O(1)
+ */
+extern int ufifo_put(UFifo *fifo, void *item);
+
+/* ufifo_get -- retire un élément de la file et renvoie un pointeur
+ * sur son contenu.
+ * Retourne NULL si la file est vide.
+ * Complexité: O(1)
+ */
+extern void *ufifo_get(UFifo *fifo);
+
+/* ufifo_trim -- libère tous les segments libres gardés en réserve.
+ * Complexité: O(nombre de segments libres)
+ */
+extern void ufifo_trim(UFifo *fifo);
+
+/* ufifo_print -- affiche une file à l'écran. Chaque élément est affiché en
+ * faisant appel à print_item.
+ * Complexité: O(ufifo_length(fifo))
+ */
+extern void ufifo_print(UFifo *fifo, void (*print_item)(void *));
+
+#endif /* UFIFO_H */
@@ -0,0 +1,344 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "ulist.h"
+
+#define ULIST_CACHE_LINE 64
+
+/* ulist_node_new (fonction interne) -- renvoie un noeud vide, aligné sur
+ * une ligne de cache, ou NULL en cas d'erreur d'allocation mémoire.
+ * Complexité: O(1)
+ */
+static ULNode *ulist_node_new(void)
+{
+  ULNode *tmp;
+
+  if (posix_memalign((void **) &tmp, ULIST_CACHE_LINE, sizeof(ULNode)) != 0) {
+#ifdef DEBUG
+    fprintf(stderr, "ulist_node_new: erreur d'allocation mémoire.\n");
+#endif
+    return NULL;
+  }
+  tmp->next = NULL;
+  tmp->count = 0;
+  return tmp;
+}
+
+/* ulist_new -- renvoie un pointeur sur une nouvelle liste (vide) ou bien
+ * NULL en cas d'erreur d'allocation mémoire.
+ * Complexité: O(1)
+ */
+UList *ulist_new()
+{
+  UList *tmp;
+
+  if ((tmp = (UList *) malloc(sizeof(UList))) == NULL) {
+#ifdef DEBUG
+    fprintf(stderr, "ulist_new: erreur d'allocation mémoire.\n");
+#endif
+    return NULL;
+  }
+  tmp->current = tmp->first = NULL;
+  tmp->pos = 0;
+  tmp->index = 0;
+  tmp->length = 0;
+  return tmp;
+}
+
+/* ulist_free -- détruit la liste passée en paramètre et libère la
+ * mémoire qu'elle occupait (mais pas celle occupée par les données).
+ * Complexité: O(longueur(list)/ULIST_NODE_ITEMS)
+ */
+void ulist_free(UList *list)
+{
+  ULNode *n, *next;
+
+  assert(list != NULL);
+  for (n = list->first; n != NULL; n = next) {
+    next = n->next;
+    free(n);
+  }
+  free(list);
+}
+
+/* ulist_empty -- teste si une liste est vide.
+ * Complexité: O(1)
+ */
+int ulist_empty(UList *list)
+{
+  assert(list != NULL);
+  return (list->length == 0);
+}
+
+/* ulist_length -- renvoie la longueur d'une liste.
+ * Complexité: O(1)
+ */
+int ulist_length(UList *list)
+{
+  assert(list != NULL);
+  return list->length;
+}
+
+/* ulist_index -- renvoie l'indice de l'élément courant dans la liste. Les
+ * éléments sont numérotés de 1 à longueur(liste). Renvoie 0 si la liste
+ * est vide.
+ * Complexité: O(1)
+ */
+int ulist_index(UList *list)
+{
+  return ulist_empty(list) ? 0 : list->index;
+}
+
+/* ulist_current -- renvoie l'élément courant, ou NULL si la liste est
+ * vide ou qu'on a dépassé la fin de la liste (avec ulist_next).
+ * Complexité: O(1)
+ */
+void *ulist_current(UList *list)
+{
+  assert(list != NULL);
+  if (list->current == NULL)
+    return NULL;
+  return list->current->items[list->pos];
+}
+
+/* ulist_reset -- place l'élément courant sur le premier de la liste.
+ * Si la liste est vide, ne fait rien.
+ * Complexité: O(1)
+ */
+void ulist_reset(UList *list)
+{
+  assert(list != NULL);
+  if (!ulist_empty(list)) {
+    list->current = list->first;
+    list->pos = 0;
+    list->index = 1;
+  }
+}
+
+/* ulist_next -- avance d'un élément dans la liste et renvoie l'élément
+ * d'arrivée. Ne fait rien (et renvoie NULL) si la liste est vide ou
+ * qu'on est déjà en fin de liste.
+ * Complexité: O(1)
+ */
+void *ulist_next(UList *list)
+{
+  assert(list != NULL);
+  if (list->current == NULL)
+    return NULL;
+  if (++list->pos == list->current->count) {
+    list->current = list->current->next;
+    list->pos = 0;
+    if (list->current == NULL)
+      return NULL;
+  }
+  list->index += 1;
+  return list->current->items[list->pos];
+}
+
+/* ulist_find -- trouve le premier élément de la liste égal à item
+ * (d'après le prédicat pred), en fait l'élément courant et le renvoie.
+ * Si l'élément n'a pas pu etre trouvé, renvoie NULL.
+ * Complexité: O(longueur(list)*C(pred))
+ */
+void *ulist_find(UList *list, void *item, int (*pred)(void *, void *))
+{
+  ULNode *n;
+  int i, index = 1;
+
+  assert((list != NULL) && (pred != NULL));
+  for (n = list->first; n != NULL; index += n->count, n = n->next)
+    for (i = 0; i < n->count; i++)
+      if (pred(n->items[i], item)) {
+        list->current = n;
+        list->pos = i;
+        list->index = index + i;
+        return n->items[i];
+      }
+  /* Pas trouvé: comme slist_find, on se retrouve après la fin */
+  list->current = NULL;
+  list->index = list->length;
+  return NULL;
+}
+
+/* ulist_insert_at (fonction interne) -- insère item en position pos du
+ * noeud n, en coupant le noeud en deux s'il est plein, et en fait
+ * l'élément courant (l'appelant met à jour list->index).
+ * La valeur de retour indique si l'insertion s'est bien passée.
+ * Complexité: O(ULIST_NODE_ITEMS)
+ */
+static int ulist_insert_at(UList *list, ULNode *n, int pos, void *item)
+{
+  ULNode *m;
+  int half = ULIST_NODE_ITEMS/2;
+
+  if (n->count == ULIST_NODE_ITEMS) {
+    /* La seconde moitié du noeud part dans un nouveau noeud */
+    if ((m = ulist_node_new()) == NULL)
+      return 0;
+    memcpy(m->items, n->items + half, (ULIST_NODE_ITEMS - half)*sizeof(void *));
+    m->count = ULIST_NODE_ITEMS - half;
+    n->count = half;
+    m->next = n->next;
+    n->next = m;
+    if (pos > half) {
+      n = m;
+      pos -= half;
+    }
+  }
+  memmove(n->items + pos + 1, n->items + pos, (n->count - pos)*sizeof(void *));
+  n->items[pos] = item;
+  n->count += 1;
+  list->current = n;
+  list->pos = pos;
+  list->length += 1;
+  return 1;
+}
+
+/* ulist_insert -- insère item à la position courante dans la liste (en
+ * tete si on a dépassé la fin). Les éléments qui suivent se retrouvent
+ * décalés d'un cran, et item devient l'élément courant.
+ * La valeur de retour indique si l'insertion s'est bien passée.
+ * Complexité: O(ULIST_NODE_ITEMS)
+ */
+int ulist_insert(UList *list, void *item)
+{
+  assert((list != NULL) && (item != NULL));
+  if (ulist_empty(list)) {
+    if ((list->first == NULL) && ((list->first = ulist_node_new()) == NULL))
+      return 0;
+    list->current = list->first;
+    list->pos = 0;
+  } else if (list->current == NULL)
+    ulist_reset(list);
+  if (!ulist_insert_at(list, list->current, list->pos, item))
+    return 0;
+  if (list->index == 0)
+    list->index = 1;
+  return 1;
+}
+
+/* ulist_insert_sorted -- insère item dans une liste triée selon cmp_func
+ * (une relation d'ordre total, <= par ex.) de façon à ce qu'elle le
+ * reste. item devient l'élément courant.
+ * La valeur de retour indique si l'insertion s'est bien passée.
+ * Complexité: O(longueur(list)*C(cmp_func)), mais seul le dernier élément
+ * de chaque noeud est comparé tant qu'on n'a pas trouvé le bon noeud
+ */
+int ulist_insert_sorted(UList *list, void *item, int (*cmp_func)(void *, void *))
+{
+  ULNode *n;
+  int i, index = 1;
+
+  assert((list != NULL) && (item != NULL) && (cmp_func != NULL));
+  if (ulist_empty(list)) {
+    list->current = NULL;
+    list->index = 0;
+    return ulist_insert(list, item);
+  }
+  /* Saute les noeuds dont toutes les données précèdent item */
+  for (n = list->first; (n->next != NULL) && cmp_func(n->items[n->count-1], item);
+       n = n->next)
+    index += n->count;
+  for (i = 0; i < n->count; i++)
+    if (!cmp_func(n->items[i], item)) break;
+  /* i == n->count: item va à la fin de la liste */
+  if (!ulist_insert_at(list, n, i, item))
+    return 0;
+  list->index = index + i;
+  return 1;
+}
+
+/* ulist_remove -- supprime l'élément courant de la liste. L'élément
+ * suivant devient l'élément courant; si on a supprimé le dernier, on
+ * revient au début de la liste (comme slist_remove).
+ * La valeur de retour indique si la suppression s'est faite.
+ * Complexité: O(ULIST_NODE_ITEMS), sauf quand le dernier noeud se vide:
+ * O(longueur(list)/ULIST_NODE_ITEMS)
+ */
+int ulist_remove(UList *list)
+{
+  ULNode *n, *m, *prev;
+  int pos, k;
+
+  assert(list != NULL);
+  if ((n = list->current) == NULL)
+    return 0;
+  pos = list->pos;
+  memmove(n->items + pos, n->items + pos + 1, (n->count - pos - 1)*sizeof(void *));
+  n->count -= 1;
+  list->length -= 1;
+  /* Un noeud à moitié vide prend des données à son suivant, ou fusionne
+   * avec lui. Les données de n restent à leur place.
+   */
+  if (((m = n->next) != NULL) && (n->count < ULIST_NODE_ITEMS/2)) {
+    if (n->count + m->count <= ULIST_NODE_ITEMS) {
+      memcpy(n->items + n->count, m->items, m->count*sizeof(void *));
+      n->count += m->count;
+      n->next = m->next;
+      free(m);
+    } else {
+      k = ULIST_NODE_ITEMS/2 - n->count;
+      memcpy(n->items + n->count, m->items, k*sizeof(void *));
+      memmove(m->items, m->items + k, (m->count - k)*sizeof(void *));
+      n->count += k;
+      m->count -= k;
+    }
+  }
+  if ((n->count == 0) && (n != list->first)) {
+    /* Le dernier noeud s'est vidé: on le retire */
+    for (prev = list->first; prev->next != n; prev = prev->next)
+      ;
+    prev->next = NULL;
+    free(n);
+    n = NULL;
+  }
+  if ((n != NULL) && (pos < n->count))
+    list->pos = pos;
+  else if ((n != NULL) && (n->next != NULL)) {
+    list->current = n->next;
+    list->pos = 0;
+  } else if (ulist_empty(list)) {
+    list->current = NULL;
+    list->index = 0;
+  } else
+    ulist_reset(list);
+  return 1;
+}
+
+/* ulist_foreach -- appelle func(élément, data) successivement sur chaque
+ * élément de la liste. Ne modifie pas l'élément courant.
+ * Complexité: O(longueur(list)*complexité(func))
+ */
+void ulist_foreach(UList *list, void (*func)(void *, void *), void *data)
+{
+  ULNode *n;
+  int i;
+
+  assert((list != NULL) && (func != NULL));
+  for (n = list->first; n != NULL; n = n->next)
+    for (i = 0; i < n->count; i++)
+      func(n->items[i], data);
+}
+
+/* ulist_print -- affiche une liste sur la sortie standard sous la forme
+ * "(item1, item2, ...)", en appelant print_item sur chaque élément. Ne
+ * modifie pas l'élément courant.
+ * Complexité: O(longueur(list)*C(print_item))
+ */
+void ulist_print(UList *list, void (*print_item)(void *))
+{
+  ULNode *n;
+  int i, first = 1;
+
+  assert((list != NULL) && (print_item != NULL));
+  putchar('(');
+  for (n = list->first; n != NULL; n = n->next)
+    for (i = 0; i < n->count; i++) {
+      if (!first) printf(", ");
+      first = 0;
+      print_item(n->items[i]);
+    }
+  putchar(')');
+}
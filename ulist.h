@@ -0,0 +1,129 @@
+#ifndef ULIST_H
+#define ULIST_H
+
+/* Liste chainée "déroulée".
+ * Chaque noeud contient un petit tableau de données au lieu d'une seule:
+ * avec ULIST_NODE_ITEMS pointeurs, un noeud occupe exactement 128 octets,
+ * soit deux lignes de cache. Un parcours lit donc les données à la suite
+ * dans un tableau, et ne suit un pointeur (avec le risque d'un défaut de
+ * cache) que tous les ULIST_NODE_ITEMS éléments, au lieu d'à chaque
+ * élément comme SList.
+ *
+ * L'interface est celle de SList (slist.h): une liste a un élément
+ * courant, numéroté de 1 à longueur(liste), et les insertions et
+ * suppressions se font à la position courante. Quand un noeud déborde,
+ * il est coupé en deux; quand il est à moitié vide, il emprunte des
+ * données à son suivant ou fusionne avec lui.
+ */
+
+#define ULIST_NODE_ITEMS 14
+
+typedef struct _ulnode {
+  struct _ulnode *next;         /* Noeud suivant */
+  int count;                    /* Nombre de données du noeud */
+  void *items[ULIST_NODE_ITEMS];  /* Les données */
+} ULNode;
+
+typedef struct {
+  ULNode *first;                /* Premier noeud */
+  ULNode *current;              /* Noeud de l'élément courant (NULL: fin) */
+  int pos;                      /* Position de l'élément courant dans son noeud */
+  int index;                    /* Numéro de l'élément courant */
+  int length;                   /* Nombre d'éléments */
+} UList;
+
+/* ulist_new -- renvoie un pointeur sur une nouvelle liste (vide) ou bien
+ * NULL en cas d'erreur d'allocation mémoire.
+ * Complexité: O(1)
+ */
+extern UList *ulist_new();
+
+/* ulist_free -- détruit la liste passée en paramètre et libère la
+ * mémoire qu'elle occupait (mais pas celle occupée par les données).
+ * Complexité: O(longueur(list)/ULIST_NODE_ITEMS)
+ */
+extern void ulist_free(UList *list);
+
+/* ulist_empty -- teste si une liste est vide.
+ * Complexité: O(1)
+ */
+extern int ulist_empty(UList *list);
+
+/* ulist_length -- renvoie la longueur d'une liste.
+ * Complexité: O(1)
+ */
+extern int ulist_length(UList *list);
+
+/* ulist_index -- renvoie l'indice de l'élément courant dans la liste. Les
+ * éléments sont numérotés de 1 à longueur(liste). Renvoie 0 si la liste
+ * est vide.
+ * Complexité: O(1)
+ */
+extern int ulist_index(UList *list);
+
+/* ulist_current -- renvoie l'élément courant, ou NULL si la liste est
+ * vide ou qu'on a dépassé la fin de la liste (avec ulist_next).
+ * Complexité: O(1)
+ */
+extern void *ulist_current(UList *list);
+
+/* ulist_reset -- place l'élément courant sur le premier de la liste.
+ * Si la liste est vide, ne fait rien.
+ * Complexité: O(1)
+ */
+extern void ulist_reset(UList *list);
+
+/* ulist_next -- avance d'un élément dans la liste et renvoie l'élément
+ * d'arrivée. Ne fait rien (et renvoie NULL) si la liste est vide ou
+ * qu'on est déjà en fin de liste.
+ * Complexité: O(1)
+ */
+extern void *ulist_next(UList *list);
+
+/* ulist_find -- trouve le premier élément de la liste égal à item
+ * (d'après le prédicat pred), en fait l'élément courant et le renvoie.
+ * Si l'élément n'a pas pu etre trouvé, renvoie NULL.
+ * Complexité: O(longueur(list)*C(pred))
+ */
+extern void *ulist_find(UList *list, void *item, int (*pred)(void *, void *));
+
+/* ulist_insert -- insère item à la position courante dans la liste (en
+ * tete si on a dépassé la fin). Les éléments qui suivent se retrouvent
+ * décalés d'un cran, et item devient l'élément courant.
+ * La valeur de retour indique si l'insertion s'est bien passée.
+ * Complexité: O(ULIST_NODE_ITEMS)
+ */
+extern int ulist_insert(UList *list, void *item);
+
+/* ulist_insert_sorted -- insère item dans une liste triée selon cmp_func
+ * (une relation d'ordre total, <= par ex.) de façon à ce qu'elle le
+ * reste. item devient l'élément courant.
+ * La valeur de retour indique si l'insertion s'est bien passée.
+ * Complexité: O(longueur(list)*C(cmp_func)), mais seul le dernier élément
+ * de chaque noeud est comparé tant qu'on n'a pas trouvé le bon noeud
+ */
+extern int ulist_insert_sorted(UList *list, void *item, int (*cmp_func)(void *, void *));
+
+/* ulist_remove -- supprime l'élément courant de la liste. L'élément
+ * suivant devient l'élément courant; si on a supprimé le dernier, on
+ * revient au début de la liste (comme slist_remove).
+ * La valeur de retour indique si la suppression s'est faite.
+ * Complexité: O(ULIST_NODE_ITEMS), sauf quand le dernier noeud se vide:
+ * O(longueur(list)/ULIST_NODE_ITEMS)
+ */
+extern int ulist_remove(UList *list);
+
+/* ulist_foreach -- appelle func(élément, data) successivement sur chaque
+ * élément de la liste. Ne modifie pas l'élément courant.
+ * Complexité: O(longueur(list)*complexité(func))
+ */
+extern void ulist_foreach(UList *list, void (*func)(void *, void *), void *data);
+
+/* ulist_print -- affiche une liste sur la sortie standard sous la forme
+ * "(item1, item2, ...)", en appelant print_item sur chaque élément. Ne
+ * modifie pas l'élément courant.
+ * Complexité: O(longueur(list)*C(print_item))
+ */
+extern void ulist_print(UList *list, void (*print_item)(void *));
+
+#endif /* ULIST_H */